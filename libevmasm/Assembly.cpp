@@ -34,12 +34,16 @@
 #include <liblangutil/CharStream.h>
 #include <liblangutil/Exceptions.h>
 
+#include <libsolutil/Parallel.h>
+
 #include <json/json.h>
 
 #include <range/v3/algorithm/any_of.hpp>
 #include <range/v3/view/enumerate.hpp>
 
+#include <exception>
 #include <fstream>
+#include <functional>
 #include <limits>
 
 using namespace solidity;
@@ -334,10 +338,69 @@ AssemblyItem Assembly::newImmutableAssignment(std::string const& _identifier)
 
 Assembly& Assembly::optimise(OptimiserSettings const& _settings)
 {
+	if (_settings.jobs > 1)
+		optimiseSubAssembliesInParallel(_settings);
 	optimiseInternal(_settings, {});
 	return *this;
 }
 
+void Assembly::optimiseSubAssembliesInParallel(OptimiserSettings const& _settings)
+{
+	if (m_tagReplacements)
+		return;
+
+	// Sub-assemblies can be shared between several parents. The sequential recursion in
+	// optimiseInternal optimises each of them only on its first visit, so we record the
+	// arguments of that visit in the same traversal order.
+	// Sub-assemblies on the same level (i.e. with the same maximum distance to a leaf)
+	// do not depend on each other and are optimised concurrently, one level after the other.
+	struct Job
+	{
+		Assembly* assembly;
+		std::set<size_t> tagsReferencedFromOutside;
+	};
+	std::vector<std::vector<Job>> jobsByLevel;
+	std::map<Assembly const*, size_t> levels;
+	std::function<size_t(Assembly&, std::set<size_t>)> collect = [&](Assembly& _assembly, std::set<size_t> _tagsReferencedFromOutside) {
+		if (_assembly.m_tagReplacements)
+			return size_t(0);
+		if (auto it = levels.find(&_assembly); it != levels.end())
+			return it->second;
+
+		size_t level = 0;
+		for (size_t subId = 0; subId < _assembly.m_subs.size(); ++subId)
+			level = std::max(
+				level,
+				collect(*_assembly.m_subs[subId], JumpdestRemover::referencedTags(_assembly.m_items, subId)) + 1
+			);
+		levels[&_assembly] = level;
+		if (jobsByLevel.size() <= level)
+			jobsByLevel.resize(level + 1);
+		jobsByLevel[level].push_back({&_assembly, std::move(_tagsReferencedFromOutside)});
+		return level;
+	};
+	for (size_t subId = 0; subId < m_subs.size(); ++subId)
+		collect(*m_subs[subId], JumpdestRemover::referencedTags(m_items, subId));
+
+	for (std::vector<Job>& jobs: jobsByLevel)
+	{
+		std::vector<std::exception_ptr> failures(jobs.size());
+		util::parallelFor(_settings.jobs, jobs.size(), [&](size_t _index) {
+			try
+			{
+				jobs[_index].assembly->optimiseInternal(_settings, std::move(jobs[_index].tagsReferencedFromOutside));
+			}
+			catch (...)
+			{
+				failures[_index] = std::current_exception();
+			}
+		});
+		for (std::exception_ptr const& failure: failures)
+			if (failure)
+				std::rethrow_exception(failure);
+	}
+}
+
 std::map<u256, u256> const& Assembly::optimiseInternal(
 	OptimiserSettings const& _settings,
 	std::set<size_t> _tagsReferencedFromOutside
@@ -428,10 +491,14 @@ std::map<u256, u256> const& Assembly::optimiseInternal(
 				return _i == AssemblyItem{Instruction::MSIZE} || _i.type() == VerbatimBytecode;
 			});
 
+			// The expression classes are only valid within a block, but their memory
+			// is reused for all blocks.
+			auto expressionClasses = std::make_shared<ExpressionClasses>();
 			auto iter = m_items.begin();
 			while (iter != m_items.end())
 			{
-				KnownState emptyState;
+				expressionClasses->clear();
+				KnownState emptyState{expressionClasses};
 				CommonSubexpressionEliminator eliminator{emptyState};
 				auto orig = iter;
 				iter = eliminator.feedItems(iter, m_items.end(), usesMSize);
@@ -595,7 +662,7 @@ LinkerObject const& Assembly::assemble() const
 		{
 			assertThrow(i.data() <= std::numeric_limits<size_t>::max(), AssemblyException, "");
 			auto s = subAssemblyById(static_cast<size_t>(i.data()))->assemble().bytecode.size();
-			i.setPushedValue(u256(s));
+			i.setPushedValue(s);
 			unsigned b = std::max<unsigned>(1, numberEncodingSize(s));
 			ret.bytecode.push_back(static_cast<uint8_t>(pushInstruction(b)));
 			ret.bytecode.resize(ret.bytecode.size() + b);
@@ -814,7 +881,7 @@ Assembly const* Assembly::subAssemblyById(size_t _subId) const
 Assembly::OptimiserSettings Assembly::OptimiserSettings::translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion)
 {
 	// Constructing it this way so that we notice changes in the fields.
-	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0};
+	evmasm::Assembly::OptimiserSettings asmSettings{false,  false, false, false, false, false, _evmVersion, 0, 1};
 	asmSettings.runInliner = _settings.runInliner;
 	asmSettings.runJumpdestRemover = _settings.runJumpdestRemover;
 	asmSettings.runPeephole = _settings.runPeephole;
@@ -129,6 +129,9 @@ public:
 		/// This specifies an estimate on how often each opcode in this assembly will be executed,
 		/// i.e. use a small value to optimise for size and a large value to optimise for runtime gas usage.
 		size_t expectedExecutionsPerDeployment = frontend::OptimiserSettings{}.expectedExecutionsPerDeployment;
+		/// Number of threads used to optimise independent sub-assemblies concurrently.
+		/// The result does not depend on it.
+		size_t jobs = 1;
 
 		static OptimiserSettings translateSettings(frontend::OptimiserSettings const& _settings, langutil::EVMVersion const& _evmVersion);
 	};
@@ -168,6 +171,11 @@ protected:
 	/// returns the replaced tags. Also takes an argument containing the tags of this assembly
 	/// that are referenced in a super-assembly.
 	std::map<u256, u256> const& optimiseInternal(OptimiserSettings const& _settings, std::set<size_t> _tagsReferencedFromOutside);
+	/// Optimises all not yet optimised sub-assemblies (transitively) of this assembly using
+	/// up to @a _settings.jobs threads, so that a subsequent call to @a optimiseInternal
+	/// only has to optimise this assembly itself.
+	/// Every sub-assembly is optimised with the same arguments as in the sequential recursion.
+	void optimiseSubAssembliesInParallel(OptimiserSettings const& _settings);
 
 	unsigned codeSize(unsigned subTagSize) const;
 
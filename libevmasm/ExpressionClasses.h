@@ -28,7 +28,9 @@
 
 #include <libsolutil/Common.h>
 
+#include <deque>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -85,6 +87,9 @@ public:
 	Expression const& representative(Id _id) const { return m_representatives.at(_id); }
 	/// @returns the number of classes.
 	size_t size() const { return m_representatives.size(); }
+	/// Removes all classes and stored items, but keeps the allocated memory, so that the
+	/// object can be reused for the next block without allocating everything again.
+	void clear();
 
 	/// Forces the given @a _item with @a _arguments to the class @a _id. This can be used to
 	/// add prior knowledge e.g. about CALLDATA, but has to be used with caution. Will not work as
@@ -105,9 +110,8 @@ public:
 	/// @returns true if the value of the given class is known to be nonzero.
 	/// @note that this is not the negation of knownZero
 	bool knownNonZero(Id _c);
-	/// @returns a pointer to the value if the given class is known to be a constant,
-	/// and a nullptr otherwise.
-	u256 const* knownConstant(Id _c);
+	/// @returns the value if the given class is known to be a constant, and nullopt otherwise.
+	std::optional<u256> knownConstant(Id _c);
 
 	/// Stores a copy of the given AssemblyItem and returns a pointer to the copy that is valid for
 	/// the lifetime of the ExpressionClasses object.
@@ -123,13 +127,13 @@ private:
 	/// Rebuilds an expression from a (matched) pattern.
 	Id rebuildExpression(ExpressionTemplate const& _template);
 
-	std::vector<std::pair<Pattern, std::function<Pattern()>>> createRules() const;
-
 	/// Expression equivalence class representatives - we only store one item of an equivalence.
 	std::vector<Expression> m_representatives;
 	/// All expression ever encountered.
 	std::unordered_set<Expression, Expression::ExpressionHash> m_expressions;
-	std::vector<std::shared_ptr<AssemblyItem>> m_spareAssemblyItems;
+	/// Copies of assembly items made by storeItem. A deque does not move its elements and allocates
+	/// them in chunks.
+	std::deque<AssemblyItem> m_storedItems;
 };
 
 }
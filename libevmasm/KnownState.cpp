@@ -120,9 +120,9 @@ KnownState::StoreOperation KnownState::feedItem(AssemblyItem const& _item, bool
 	else if (_item.type() != Operation)
 	{
 		assertThrow(_item.deposit() == 1, InvalidDeposit, "");
-		if (_item.pushedValue())
+		if (std::optional<u256> pushedValue = _item.pushedValue())
 			// only available after assembly stage, should not be used for optimisation
-			setStackElement(++m_stackHeight, m_expressionClasses->find(*_item.pushedValue()));
+			setStackElement(++m_stackHeight, m_expressionClasses->find(*pushedValue));
 		else
 			setStackElement(++m_stackHeight, m_expressionClasses->find(_item, {}, _copyItem));
 	}
@@ -250,7 +250,7 @@ void KnownState::reduceToCommonKnowledge(KnownState const& _other, bool _combine
 	// Use the smaller stack height. Essential to terminate in case of loops.
 	if (m_stackHeight > _other.m_stackHeight)
 	{
-		std::map<int, Id> shiftedStack;
+		StackElements shiftedStack;
 		for (auto const& stackElement: m_stackElements)
 			shiftedStack[stackElement.first - stackDiff] = stackElement.second;
 		m_stackElements = std::move(shiftedStack);
@@ -394,7 +394,7 @@ KnownState::Id KnownState::applyKeccak256(
 {
 	AssemblyItem keccak256Item(Instruction::KECCAK256, _location);
 	// Special logic if length is a short constant, otherwise we cannot tell.
-	u256 const* l = m_expressionClasses->knownConstant(_length);
+	std::optional<u256> l = m_expressionClasses->knownConstant(_length);
 	// unknown or too large length
 	if (!l || *l > 128)
 		return m_expressionClasses->find(keccak256Item, {_start, _length}, true, m_sequenceNumber);
@@ -36,6 +36,7 @@
 #endif
 
 #include <boost/bimap.hpp>
+#include <boost/container/flat_map.hpp>
 
 #if defined(_MSC_VER)
 #pragma warning(pop)
@@ -82,6 +83,9 @@ class KnownState
 {
 public:
 	using Id = ExpressionClasses::Id;
+	/// Mapping stack height -> equivalence class. Kept sorted in a single allocation, since
+	/// states are copied often and there are only a few elements.
+	using StackElements = boost::container::flat_map<int, Id>;
 	struct StoreOperation
 	{
 		enum Target { Invalid, Memory, Storage };
@@ -146,10 +150,10 @@ public:
 	void clearTagUnions();
 
 	int stackHeight() const { return m_stackHeight; }
-	std::map<int, Id> const& stackElements() const { return m_stackElements; }
+	StackElements const& stackElements() const { return m_stackElements; }
 	ExpressionClasses& expressionClasses() const { return *m_expressionClasses; }
 
-	std::map<Id, Id> const& storageContent() const { return m_storageContent; }
+	boost::container::flat_map<Id, Id> const& storageContent() const { return m_storageContent; }
 
 private:
 	/// Assigns a new equivalence class to the next sequence number of the given stack element.
@@ -178,14 +182,14 @@ private:
 	/// Current stack height, can be negative.
 	int m_stackHeight = 0;
 	/// Current stack layout, mapping stack height -> equivalence class
-	std::map<int, Id> m_stackElements;
+	StackElements m_stackElements;
 	/// Current sequence number, this is incremented with each modification to storage or memory.
 	unsigned m_sequenceNumber = 1;
 	/// Knowledge about storage content.
-	std::map<Id, Id> m_storageContent;
+	boost::container::flat_map<Id, Id> m_storageContent;
 	/// Knowledge about memory content. Keys are memory addresses, note that the values overlap
 	/// and are not contained here if they are not completely known.
-	std::map<Id, Id> m_memoryContent;
+	boost::container::flat_map<Id, Id> m_memoryContent;
 	/// Keeps record of all Keccak-256 hashes that are computed. The first parameter in the
 	/// std::pair corresponds to memory content and the second parameter corresponds to the length
 	/// that is accessed.
@@ -25,6 +25,9 @@
 #include <libevmasm/AssemblyItem.h>
 #include <libevmasm/SemanticInformation.h>
 
+#include <array>
+#include <vector>
+
 using namespace solidity;
 using namespace solidity::evmasm;
 
@@ -78,6 +81,10 @@ struct SimplePeepholeOptimizerMethod
 
 struct Identity: SimplePeepholeOptimizerMethod<Identity>
 {
+	static bool mayStartWith(AssemblyItem const&)
+	{
+		return true;
+	}
 	static bool applySimple(
 		AssemblyItem const& _item,
 		std::back_insert_iterator<AssemblyItems> _out
@@ -90,6 +97,14 @@ struct Identity: SimplePeepholeOptimizerMethod<Identity>
 
 struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		auto t = _item.type();
+		return
+			SemanticInformation::isDupInstruction(_item) ||
+			t == Push || t == PushTag || t == PushSub ||
+			t == PushSubSize || t == PushProgramSize || t == PushData || t == PushLibraryAddress;
+	}
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _pop,
@@ -107,6 +122,13 @@ struct PushPop: SimplePeepholeOptimizerMethod<PushPop>
 
 struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return
+			_item.type() == Operation &&
+			instructionInfo(_item.instruction(), langutil::EVMVersion()).ret == 1 &&
+			!instructionInfo(_item.instruction(), langutil::EVMVersion()).sideEffects;
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _pop,
@@ -129,6 +151,12 @@ struct OpPop: SimplePeepholeOptimizerMethod<OpPop>
 
 struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return
+			(_item.type() == Operation && !instructionInfo(_item.instruction(), langutil::EVMVersion()).sideEffects) ||
+			_item.type() == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _stop,
@@ -158,6 +186,10 @@ struct OpStop: SimplePeepholeOptimizerMethod<OpStop>
 
 struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return OpStop::mayStartWith(_item);
+	}
 	static bool applySimple(
 		AssemblyItem const& _op,
 		AssemblyItem const& _push,
@@ -187,6 +219,10 @@ struct OpReturnRevert: SimplePeepholeOptimizerMethod<OpReturnRevert>
 
 struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return SemanticInformation::isSwapInstruction(_item);
+	}
 	static size_t applySimple(
 		AssemblyItem const& _s1,
 		AssemblyItem const& _s2,
@@ -199,6 +235,10 @@ struct DoubleSwap: SimplePeepholeOptimizerMethod<DoubleSwap>
 
 struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _push1,
 		AssemblyItem const& _push2,
@@ -218,6 +258,10 @@ struct DoublePush: SimplePeepholeOptimizerMethod<DoublePush>
 
 struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return _item == Instruction::SWAP1;
+	}
 	static bool applySimple(
 		AssemblyItem const& _swap,
 		AssemblyItem const& _op,
@@ -240,6 +284,10 @@ struct CommutativeSwap: SimplePeepholeOptimizerMethod<CommutativeSwap>
 
 struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return _item == Instruction::SWAP1;
+	}
 	static bool applySimple(
 		AssemblyItem const& _swap,
 		AssemblyItem const& _op,
@@ -270,6 +318,10 @@ struct SwapComparison: SimplePeepholeOptimizerMethod<SwapComparison>
 /// Remove swapN after dupN
 struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return SemanticInformation::isDupInstruction(_item);
+	}
 	static size_t applySimple(
 		AssemblyItem const& _dupN,
 		AssemblyItem const& _swapN,
@@ -293,6 +345,10 @@ struct DupSwap: SimplePeepholeOptimizerMethod<DupSwap>
 
 struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return _item == Instruction::ISZERO;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _iszero1,
 		AssemblyItem const& _iszero2,
@@ -319,6 +375,10 @@ struct IsZeroIsZeroJumpI: SimplePeepholeOptimizerMethod<IsZeroIsZeroJumpI>
 
 struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return _item == Instruction::EQ;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _eq,
 		AssemblyItem const& _iszero,
@@ -347,6 +407,10 @@ struct EqIsZeroJumpI: SimplePeepholeOptimizerMethod<EqIsZeroJumpI>
 // push_tag_1 jumpi push_tag_2 jump tag_1: -> iszero push_tag_2 jumpi tag_1:
 struct DoubleJump: SimplePeepholeOptimizerMethod<DoubleJump>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == PushTag;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _pushTag1,
 		AssemblyItem const& _jumpi,
@@ -378,6 +442,10 @@ struct DoubleJump: SimplePeepholeOptimizerMethod<DoubleJump>
 
 struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == PushTag;
+	}
 	static size_t applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _jump,
@@ -404,6 +472,10 @@ struct JumpToNext: SimplePeepholeOptimizerMethod<JumpToNext>
 
 struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == PushTag || _item.type() == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _pushTag,
 		AssemblyItem const& _pushConstant,
@@ -439,6 +511,10 @@ struct TagConjunctions: SimplePeepholeOptimizerMethod<TagConjunctions>
 
 struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return _item.type() == Push;
+	}
 	static bool applySimple(
 		AssemblyItem const& _push,
 		AssemblyItem const& _not,
@@ -457,20 +533,23 @@ struct TruthyAnd: SimplePeepholeOptimizerMethod<TruthyAnd>
 /// Removes everything after a JUMP (or similar) until the next JUMPDEST.
 struct UnreachableCode
 {
+	static bool mayStartWith(AssemblyItem const& _item)
+	{
+		return
+			_item == Instruction::JUMP ||
+			_item == Instruction::RETURN ||
+			_item == Instruction::STOP ||
+			_item == Instruction::INVALID ||
+			_item == Instruction::SELFDESTRUCT ||
+			_item == Instruction::REVERT;
+	}
 	static bool apply(OptimiserState& _state)
 	{
 		auto it = _state.items.begin() + static_cast<ptrdiff_t>(_state.i);
 		auto end = _state.items.end();
 		if (it == end)
 			return false;
-		if (
-			it[0] != Instruction::JUMP &&
-			it[0] != Instruction::RETURN &&
-			it[0] != Instruction::STOP &&
-			it[0] != Instruction::INVALID &&
-			it[0] != Instruction::SELFDESTRUCT &&
-			it[0] != Instruction::REVERT
-		)
+		if (!mayStartWith(it[0]))
 			return false;
 
 		ptrdiff_t i = 1;
@@ -487,17 +566,54 @@ struct UnreachableCode
 	}
 };
 
-void applyMethods(OptimiserState&)
+/// @returns the key of an item that determines which methods can match at its position:
+/// the instruction for operations and the item type otherwise.
+size_t dispatchKey(AssemblyItem const& _item)
 {
-	assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	if (_item.type() == Operation)
+		return static_cast<size_t>(_item.instruction());
+	else
+		return 0x100 + static_cast<size_t>(_item.type());
 }
 
-template <typename Method, typename... OtherMethods>
-void applyMethods(OptimiserState& _state, Method, OtherMethods... _other)
+size_t constexpr dispatchKeyCount = 0x100 + static_cast<size_t>(VerbatimBytecode) + 1;
+
+/// Table of the methods that can match a window starting with an item of a given dispatch key,
+/// in the order of @a Methods. It is built once from the @a mayStartWith functions of the methods,
+/// so that only those have to be tried at each position.
+template <typename... Methods>
+class MethodDispatcher
 {
-	if (!Method::apply(_state))
-		applyMethods(_state, _other...);
-}
+public:
+	MethodDispatcher()
+	{
+		for (size_t key = 0; key < dispatchKeyCount; ++key)
+		{
+			AssemblyItem item = key < 0x100 ?
+				AssemblyItem(static_cast<Instruction>(key)) :
+				AssemblyItem(static_cast<AssemblyItemType>(key - 0x100));
+			(addIfApplicable<Methods>(key, item), ...);
+		}
+	}
+
+	void apply(OptimiserState& _state) const
+	{
+		for (auto method: m_methods[dispatchKey(_state.items[_state.i])])
+			if (method(_state))
+				return;
+		assertThrow(false, OptimizerException, "Peephole optimizer failed to apply identity.");
+	}
+
+private:
+	template <typename Method>
+	void addIfApplicable(size_t _key, AssemblyItem const& _item)
+	{
+		if (Method::mayStartWith(_item))
+			m_methods[_key].push_back(&Method::apply);
+	}
+
+	std::array<std::vector<bool(*)(OptimiserState&)>, dispatchKeyCount> m_methods;
+};
 
 size_t numberOfPops(AssemblyItems const& _items)
 {
@@ -510,14 +626,17 @@ bool PeepholeOptimiser::optimise()
 {
 	// Avoid referencing immutables too early by using approx. counting in bytesRequired()
 	auto const approx = evmasm::Precision::Approximate;
+	static MethodDispatcher<
+		PushPop, OpPop, OpStop, OpReturnRevert, DoublePush, DoubleSwap, CommutativeSwap, SwapComparison,
+		DupSwap, IsZeroIsZeroJumpI, EqIsZeroJumpI, DoubleJump, JumpToNext, UnreachableCode,
+		TagConjunctions, TruthyAnd, Identity
+	> const dispatcher;
+
+	m_optimisedItems.clear();
+	m_optimisedItems.reserve(m_items.size());
 	OptimiserState state {m_items, 0, back_inserter(m_optimisedItems)};
 	while (state.i < m_items.size())
-		applyMethods(
-			state,
-			PushPop(), OpPop(), OpStop(), OpReturnRevert(), DoublePush(), DoubleSwap(), CommutativeSwap(), SwapComparison(),
-			DupSwap(), IsZeroIsZeroJumpI(), EqIsZeroJumpI(), DoubleJump(), JumpToNext(), UnreachableCode(),
-			TagConjunctions(), TruthyAnd(), Identity()
-		);
+		dispatcher.apply(state);
 	if (m_optimisedItems.size() < m_items.size() || (
 		m_optimisedItems.size() == m_items.size() && (
 			evmasm::bytesRequired(m_optimisedItems, 3, approx) < evmasm::bytesRequired(m_items, 3, approx) ||
@@ -28,6 +28,8 @@
 
 #include <cstdlib>
 #include <list>
+#include <mutex>
+#include <new>
 #include <string>
 
 #include "license.h"
@@ -44,6 +46,15 @@ namespace
 // The std::strings in this list must not be resized after they have been added here (via solidity_alloc()), because
 // this may potentially change the pointer that was passed to the caller from solidity_alloc().
 static std::list<std::string> solidityAllocations;
+// Guards solidityAllocations, which read callbacks of concurrent compilations access.
+static std::mutex solidityAllocationsMutex;
+
+/// Adds @p _data to the list of allocations and @returns a pointer to its contents.
+char* addAllocation(std::string _data)
+{
+	std::lock_guard<std::mutex> lock(solidityAllocationsMutex);
+	return solidityAllocations.emplace_back(std::move(_data)).data();
+}
 
 /// Find the equivalent to @p _data in the list of allocations of solidity_alloc(),
 /// removes it from the list and returns its value.
@@ -52,6 +63,7 @@ static std::list<std::string> solidityAllocations;
 /// on the caller-side and hence, will call abort() then.
 std::string takeOverAllocation(char const* _data)
 {
+	std::lock_guard<std::mutex> lock(solidityAllocationsMutex);
 	for (auto iter = begin(solidityAllocations); iter != end(solidityAllocations); ++iter)
 		if (iter->data() == _data)
 		{
@@ -113,6 +125,13 @@ std::string compile(std::string _input, CStyleReadFileCallback _readCallback, vo
 
 }
 
+/// State of a compilation context. The output of the last compilation is kept here
+/// instead of the global list of allocations, so that contexts do not share anything.
+struct solidity_context
+{
+	std::string output;
+};
+
 extern "C"
 {
 extern char const* solidity_license() noexcept
@@ -128,14 +147,14 @@ extern char const* solidity_version() noexcept
 
 extern char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) noexcept
 {
-	return solidityAllocations.emplace_back(compile(_input, _readCallback, _readContext)).data();
+	return addAllocation(compile(_input, _readCallback, _readContext));
 }
 
 extern char* solidity_alloc(size_t _size) noexcept
 {
 	try
 	{
-		return solidityAllocations.emplace_back(_size, '\0').data();
+		return addAllocation(std::string(_size, '\0'));
 	}
 	catch (...)
 	{
@@ -152,8 +171,31 @@ extern void solidity_free(char* _data) noexcept
 extern void solidity_reset() noexcept
 {
 	// This is called right before each compilation, but not at the end, so additional memory
-	// can be freed here.
+	// can be freed here. Compilations themselves do not reset the YulString repository,
+	// because compilations in other contexts may still use its strings.
 	yul::YulStringRepository::reset();
+	std::lock_guard<std::mutex> lock(solidityAllocationsMutex);
 	solidityAllocations.clear();
 }
+
+extern solidity_context* solidity_create_context() noexcept
+{
+	return new (std::nothrow) solidity_context{};
+}
+
+extern char const* solidity_compile_with_context(
+	solidity_context* _context,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) noexcept
+{
+	_context->output = compile(_input, _readCallback, _readContext);
+	return _context->output.c_str();
+}
+
+extern void solidity_free_context(solidity_context* _context) noexcept
+{
+	delete _context;
+}
 }
@@ -63,6 +63,7 @@ char const* solidity_license() SOLC_NOEXCEPT;
 char const* solidity_version() SOLC_NOEXCEPT;
 
 /// Allocates a chunk of memory of @p _size bytes.
+/// This function is thread-safe.
 ///
 /// Use this function inside callbacks to allocate data that is to be passed to
 /// the compiler. You may use solidity_free() or solidity_reset() to free this
@@ -73,7 +74,7 @@ char const* solidity_version() SOLC_NOEXCEPT;
 char* solidity_alloc(size_t _size) SOLC_NOEXCEPT;
 
 /// Explicitly frees the memory (@p _data) that was being allocated with solidity_alloc()
-/// or returned by a call to solidity_compile().
+/// or returned by a call to solidity_compile(). This function is thread-safe.
 ///
 /// Important, this call will abort() in case of any invalid argument being passed to this call.
 void solidity_free(char* _data) SOLC_NOEXCEPT;
@@ -90,12 +91,46 @@ void solidity_free(char* _data) SOLC_NOEXCEPT;
 /// @returns A pointer to the result. The pointer returned must be freed by the caller using solidity_free() or solidity_reset().
 char* solidity_compile(char const* _input, CStyleReadFileCallback _readCallback, void* _readContext) SOLC_NOEXCEPT;
 
-/// Frees up any allocated memory.
+/// Frees up any allocated memory, including the identifiers that compilations keep interned
+/// for later compilations.
 ///
 /// NOTE: the pointer returned by solidity_compile as well as any other pointer retrieved via solidity_alloc()
 /// is invalid after calling this!
+/// This must not be called while a compilation is running on any thread.
 void solidity_reset() SOLC_NOEXCEPT;
 
+/// Opaque handle to a compilation context, see solidity_create_context().
+typedef struct solidity_context solidity_context;
+
+/// Creates a new compilation context.
+///
+/// Compilations in different contexts do not share any unsynchronized state and can run
+/// concurrently on separate threads. A single context must not be used by several threads at
+/// the same time.
+///
+/// @returns the new context, which must be released with solidity_free_context(),
+/// or NULL if it could not be allocated.
+solidity_context* solidity_create_context() SOLC_NOEXCEPT;
+
+/// Same as solidity_compile(), but performs the compilation in @p _context.
+///
+/// @param _context The context created by solidity_create_context().
+/// @param _input The input JSON to process.
+/// @param _readCallback The optional callback pointer. Can be NULL.
+/// @param _readContext An optional context pointer passed to _readCallback. Can be NULL.
+///
+/// @returns A pointer to the result. It is owned by @p _context and stays valid until the next
+/// compilation in @p _context or until the context is freed. It must NOT be freed by the caller.
+char const* solidity_compile_with_context(
+	solidity_context* _context,
+	char const* _input,
+	CStyleReadFileCallback _readCallback,
+	void* _readContext
+) SOLC_NOEXCEPT;
+
+/// Frees @p _context and the result of its last compilation. Passing NULL is allowed.
+void solidity_free_context(solidity_context* _context) SOLC_NOEXCEPT;
+
 #ifdef __cplusplus
 }
 #endif
@@ -282,8 +282,13 @@ public:
 	/// Appends arbitrary data to the end of the bytecode.
 	void appendToAuxiliaryData(bytes const& _data) { m_asm->appendToAuxiliaryData(_data); }
 
-	/// Run optimisation step.
-	void optimise(OptimiserSettings const& _settings) { m_asm->optimise(evmasm::Assembly::OptimiserSettings::translateSettings(_settings, m_evmVersion)); }
+	/// Run optimisation step, optimising sub-assemblies on up to @a _jobs threads.
+	void optimise(OptimiserSettings const& _settings, size_t _jobs = 1)
+	{
+		auto asmSettings = evmasm::Assembly::OptimiserSettings::translateSettings(_settings, m_evmVersion);
+		asmSettings.jobs = _jobs;
+		m_asm->optimise(asmSettings);
+	}
 
 	/// @returns the runtime context if in creation mode and runtime context is set, nullptr otherwise.
 	CompilerContext* runtimeContext() const { return m_runtimeContext; }
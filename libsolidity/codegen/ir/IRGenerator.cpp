@@ -89,16 +89,19 @@ set<CallableDeclaration const*, ASTNode::CompareByID> collectReachableCallables(
 
 }
 
-string IRGenerator::run(
+pair<string, string> IRGenerator::run(
 	ContractDefinition const& _contract,
 	bytes const& _cborMetadata,
 	map<ContractDefinition const*, string_view const> const& _otherYulSources
 )
 {
-	return yul::reindent(generate(_contract, _cborMetadata, _otherYulSources));
+	auto [ir, irWithPlaceholders] = generate(_contract, _cborMetadata, _otherYulSources);
+	if (!irWithPlaceholders.empty())
+		irWithPlaceholders = yul::reindent(irWithPlaceholders);
+	return {yul::reindent(ir), std::move(irWithPlaceholders)};
 }
 
-string IRGenerator::generate(
+pair<string, string> IRGenerator::generate(
 	ContractDefinition const& _contract,
 	bytes const& _cborMetadata,
 	map<ContractDefinition const*, string_view const> const& _otherYulSources
@@ -111,6 +114,13 @@ string IRGenerator::generate(
 			subObjectsSources += _otherYulSources.at(subObject);
 		return subObjectsSources;
 	};
+	auto subObjectPlaceholders = [](std::set<ContractDefinition const*, ASTNode::CompareByID> const& subObjects) -> string
+	{
+		std::string placeholders;
+		for (ContractDefinition const* subObject: subObjects)
+			placeholders += "object \"" + IRNames::creationObject(*subObject) + "\" { code {} }\n";
+		return placeholders;
+	};
 	auto formatUseSrcMap = [](IRGenerationContext const& _context) -> string
 	{
 		return joinHumanReadable(
@@ -184,7 +194,7 @@ string IRGenerator::generate(
 	InternalDispatchMap internalDispatchMap = generateInternalDispatchFunctions(_contract);
 
 	t("functions", m_context.functionCollector().requestedFunctions());
-	t("subObjects", subObjectSources(m_context.subObjectsCreated()));
+	auto creationSubObjects = m_context.subObjectsCreated();
 
 	// This has to be called only after all other code generation for the creation object is complete.
 	bool creationInvolvesMemoryUnsafeAssembly = m_context.memoryUnsafeInlineAssemblySeen();
@@ -206,7 +216,7 @@ string IRGenerator::generate(
 	set<FunctionDefinition const*> deployedFunctionList = generateQueuedFunctions();
 	generateInternalDispatchFunctions(_contract);
 	t("deployedFunctions", m_context.functionCollector().requestedFunctions());
-	t("deployedSubObjects", subObjectSources(m_context.subObjectsCreated()));
+	auto deployedSubObjects = m_context.subObjectsCreated();
 	t("metadataName", yul::Object::metadataName());
 	t("cborMetadata", util::toHex(_cborMetadata));
 
@@ -221,7 +231,18 @@ string IRGenerator::generate(
 	verifyCallGraph(collectReachableCallables(**_contract.annotation().creationCallGraph), std::move(creationFunctionList));
 	verifyCallGraph(collectReachableCallables(**_contract.annotation().deployedCallGraph), std::move(deployedFunctionList));
 
-	return t.render();
+	// Without created contracts, the code with placeholders would be the same as the code itself.
+	string irWithPlaceholders;
+	if (!creationSubObjects.empty() || !deployedSubObjects.empty())
+	{
+		Whiskers withPlaceholders = t;
+		withPlaceholders("subObjects", subObjectPlaceholders(creationSubObjects));
+		withPlaceholders("deployedSubObjects", subObjectPlaceholders(deployedSubObjects));
+		irWithPlaceholders = withPlaceholders.render();
+	}
+	t("subObjects", subObjectSources(creationSubObjects));
+	t("deployedSubObjects", subObjectSources(deployedSubObjects));
+	return {t.render(), std::move(irWithPlaceholders)};
 }
 
 string IRGenerator::generate(Block const& _block)
@@ -66,15 +66,20 @@ public:
 		m_utils(_evmVersion, m_context.revertStrings(), m_context.functionCollector())
 	{}
 
-	/// Generates and returns (unoptimized) IR code.
-	std::string run(
+	/// Generates (unoptimized) IR code.
+	/// @returns the IR code and the same code in which the objects of the contracts created by
+	/// @a _contract are replaced by empty placeholder objects with the same names. The latter
+	/// does not depend on @a _otherYulSources and lets the caller reuse the objects of the created
+	/// contracts instead of parsing their code again. The latter is empty if @a _contract does not
+	/// create any contracts.
+	std::pair<std::string, std::string> run(
 		ContractDefinition const& _contract,
 		bytes const& _cborMetadata,
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
 	);
 
 private:
-	std::string generate(
+	std::pair<std::string, std::string> generate(
 		ContractDefinition const& _contract,
 		bytes const& _cborMetadata,
 		std::map<ContractDefinition const*, std::string_view const> const& _otherYulSources
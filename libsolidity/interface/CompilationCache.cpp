@@ -0,0 +1,190 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolidity/interface/CompilationCache.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/JSON.h>
+
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <fstream>
+#include <tuple>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::util;
+
+namespace fs = boost::filesystem;
+
+namespace
+{
+
+string const statisticsFileName = "statistics.json";
+
+bool isEntry(fs::path const& _path)
+{
+	string const name = _path.filename().string();
+	return name.size() == 64 && all_of(name.begin(), name.end(), [](char _c) { return isxdigit(_c) != 0; });
+}
+
+/// Writes @a _content to a temporary file first and then renames it to @a _path,
+/// so that concurrent readers never see a partially written file.
+void writeAtomically(fs::path const& _path, string const& _content)
+{
+	fs::path temporaryPath = _path;
+	temporaryPath += "." + fs::unique_path().string() + ".tmp";
+	{
+		ofstream file(temporaryPath.string(), ios::binary | ios::trunc);
+		file << _content;
+		if (!file)
+		{
+			file.close();
+			fs::remove(temporaryPath);
+			return;
+		}
+	}
+	fs::rename(temporaryPath, _path);
+}
+
+}
+
+CompilationCache::CompilationCache(fs::path _directory, uint64_t _maxSize):
+	m_directory(std::move(_directory)),
+	m_maxSize(_maxSize)
+{
+	boost::system::error_code ignored;
+	fs::create_directories(m_directory, ignored);
+}
+
+optional<string> CompilationCache::load(h256 const& _key) const
+{
+	try
+	{
+		fs::path const path = entryPath(_key);
+		if (!fs::is_regular_file(path))
+			return nullopt;
+		string content = readFileAsString(path);
+		// The modification time is used as the time of last use for eviction.
+		boost::system::error_code ignored;
+		fs::last_write_time(path, time(nullptr), ignored);
+		return content;
+	}
+	catch (...)
+	{
+		return nullopt;
+	}
+}
+
+void CompilationCache::store(h256 const& _key, string const& _value)
+{
+	try
+	{
+		if (_value.size() > m_maxSize)
+			return;
+		writeAtomically(entryPath(_key), _value);
+		evict(_key);
+	}
+	catch (...)
+	{
+	}
+}
+
+void CompilationCache::recordLookup(bool _hit)
+{
+	Statistics delta;
+	(_hit ? delta.hits : delta.misses) = 1;
+	(_hit ? m_statistics.hits : m_statistics.misses)++;
+	updatePersistentStatistics(delta);
+}
+
+CompilationCache::Statistics CompilationCache::persistentStatistics() const
+{
+	Statistics statistics;
+	try
+	{
+		Json::Value json;
+		fs::path const path = m_directory / statisticsFileName;
+		if (fs::is_regular_file(path) && jsonParseStrict(readFileAsString(path), json) && json.isObject())
+		{
+			statistics.hits = json.get("hits", 0).asUInt64();
+			statistics.misses = json.get("misses", 0).asUInt64();
+			statistics.evictions = json.get("evictions", 0).asUInt64();
+		}
+	}
+	catch (...)
+	{
+	}
+	return statistics;
+}
+
+fs::path CompilationCache::entryPath(h256 const& _key) const
+{
+	return m_directory / _key.hex();
+}
+
+void CompilationCache::evict(h256 const& _keep)
+{
+	vector<tuple<time_t, fs::path, uint64_t>> entries;
+	uint64_t totalSize = 0;
+	for (fs::directory_entry const& entry: fs::directory_iterator(m_directory))
+		if (isEntry(entry.path()) && fs::is_regular_file(entry.path()))
+		{
+			uint64_t const size = fs::file_size(entry.path());
+			if (entry.path() != entryPath(_keep))
+				entries.emplace_back(fs::last_write_time(entry.path()), entry.path(), size);
+			totalSize += size;
+		}
+	if (totalSize <= m_maxSize)
+		return;
+
+	// Oldest first.
+	sort(entries.begin(), entries.end());
+	Statistics delta;
+	for (auto const& [lastUse, path, size]: entries)
+	{
+		if (totalSize <= m_maxSize)
+			break;
+		boost::system::error_code error;
+		if (fs::remove(path, error))
+			delta.evictions++;
+		totalSize -= size;
+	}
+	m_statistics.evictions += delta.evictions;
+	updatePersistentStatistics(delta);
+}
+
+void CompilationCache::updatePersistentStatistics(Statistics const& _delta)
+{
+	// Concurrent updates by several processes can get lost, the statistics are only indicative.
+	try
+	{
+		Statistics statistics = persistentStatistics();
+		Json::Value json(Json::objectValue);
+		json["hits"] = Json::UInt64(statistics.hits + _delta.hits);
+		json["misses"] = Json::UInt64(statistics.misses + _delta.misses);
+		json["evictions"] = Json::UInt64(statistics.evictions + _delta.evictions);
+		writeAtomically(m_directory / statisticsFileName, jsonCompactPrint(json));
+	}
+	catch (...)
+	{
+	}
+}
@@ -0,0 +1,85 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Persistent, content-addressed cache of compilation results.
+ */
+
+#pragma once
+
+#include <libsolutil/FixedHash.h>
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace solidity::frontend
+{
+
+/**
+ * Cache of compilation results in a directory on disk, keyed by hashes provided by the caller.
+ * Once the total size of all entries exceeds the configured limit, the least recently used
+ * entries are removed. Several processes can share a directory: entries are only ever
+ * replaced as a whole. Problems accessing the directory are not reported, they turn lookups
+ * into misses and make storing a no-op.
+ */
+class CompilationCache
+{
+public:
+	struct Statistics
+	{
+		uint64_t hits = 0;
+		uint64_t misses = 0;
+		uint64_t evictions = 0;
+	};
+
+	/// Uses @a _directory as storage, creating it if necessary.
+	/// @param _maxSize maximum total size of all entries in bytes.
+	CompilationCache(boost::filesystem::path _directory, uint64_t _maxSize);
+
+	boost::filesystem::path const& directory() const { return m_directory; }
+	uint64_t maxSize() const { return m_maxSize; }
+
+	/// @returns the value stored under @a _key and marks it as recently used, or nullopt if there is none.
+	std::optional<std::string> load(util::h256 const& _key) const;
+	/// Stores @a _value under @a _key and evicts the least recently used entries
+	/// if the size limit is exceeded.
+	void store(util::h256 const& _key, std::string const& _value);
+
+	/// Counts a lookup of a compilation result, both for this process and in the statistics
+	/// kept in the cache directory.
+	void recordLookup(bool _hit);
+
+	/// @returns the statistics of this process.
+	Statistics const& statistics() const { return m_statistics; }
+	/// @returns the statistics accumulated by all processes that used the cache directory.
+	Statistics persistentStatistics() const;
+
+private:
+	boost::filesystem::path entryPath(util::h256 const& _key) const;
+	/// Removes the least recently used entries except @a _keep until the size limit is met.
+	void evict(util::h256 const& _keep);
+	void updatePersistentStatistics(Statistics const& _delta);
+
+	boost::filesystem::path m_directory;
+	uint64_t m_maxSize;
+	Statistics m_statistics;
+};
+
+}
@@ -64,9 +64,12 @@
 #include <libyul/YulString.h>
 #include <libyul/AsmPrinter.h>
 #include <libyul/AsmJsonConverter.h>
+#include <libyul/Object.h>
 #include <libyul/YulStack.h>
 #include <libyul/AST.h>
 #include <libyul/AsmParser.h>
+#include <libyul/optimiser/ASTWalker.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 
 #include <liblangutil/Scanner.h>
 #include <liblangutil/SemVerHandler.h>
@@ -79,6 +82,7 @@
 #include <libsolutil/JSON.h>
 #include <libsolutil/Algorithms.h>
 #include <libsolutil/FunctionSelector.h>
+#include <libsolutil/Parallel.h>
 
 #include <json/json.h>
 
@@ -102,23 +106,14 @@ using namespace solidity::stdlib;
 
 using solidity::util::errinfo_comment;
 
-static int g_compilerStackCounts = 0;
-
 CompilerStack::CompilerStack(ReadCallback::Callback _readFile):
 	m_readFile{std::move(_readFile)},
+	m_typeProvider{make_unique<TypeProvider>()},
 	m_errorReporter{m_errorList}
 {
-	// Because TypeProvider is currently a singleton API, we must ensure that
-	// no more than one entity is actually using it at a time.
-	solAssert(g_compilerStackCounts == 0, "You shall not have another CompilerStack aside me.");
-	++g_compilerStackCounts;
 }
 
-CompilerStack::~CompilerStack()
-{
-	--g_compilerStackCounts;
-	TypeProvider::reset();
-}
+CompilerStack::~CompilerStack() = default;
 
 void CompilerStack::createAndAssignCallGraphs()
 {
@@ -219,8 +214,8 @@ void CompilerStack::setRemappings(vector<ImportRemapper::Remapping> _remappings)
 
 void CompilerStack::setViaIR(bool _viaIR)
 {
-	if (m_stackState >= ParsedAndImported)
-		solThrow(CompilerError, "Must set viaIR before parsing.");
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set viaIR before compiling.");
 	m_viaIR = _viaIR;
 }
 
@@ -240,6 +235,14 @@ void CompilerStack::setEOFVersion(std::optional<uint8_t> _version)
 	m_eofVersion = _version;
 }
 
+void CompilerStack::setParallelJobs(size_t _jobs)
+{
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set the number of parallel jobs before compiling.");
+	solAssert(_jobs > 0, "");
+	m_parallelJobs = _jobs;
+}
+
 void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
 {
 	if (m_stackState >= ParsedAndImported)
@@ -249,8 +252,8 @@ void CompilerStack::setModelCheckerSettings(ModelCheckerSettings _settings)
 
 void CompilerStack::setLibraries(map<string, util::h192> const& _libraries)
 {
-	if (m_stackState >= ParsedAndImported)
-		solThrow(CompilerError, "Must set libraries before parsing.");
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set libraries before compiling.");
 	m_libraries = _libraries;
 }
 
@@ -263,30 +266,33 @@ void CompilerStack::setOptimiserSettings(bool _optimize, size_t _runs)
 
 void CompilerStack::setOptimiserSettings(OptimiserSettings _settings)
 {
-	if (m_stackState >= ParsedAndImported)
-		solThrow(CompilerError, "Must set optimiser settings before parsing.");
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set optimiser settings before compiling.");
+	// The syntax checker depends on whether the Yul optimiser is enabled.
+	if (m_stackState >= ParsedAndImported && _settings.runYulOptimiser != m_optimiserSettings.runYulOptimiser)
+		solThrow(CompilerError, "Must enable or disable the Yul optimiser before parsing.");
 	m_optimiserSettings = std::move(_settings);
 }
 
 void CompilerStack::setRevertStringBehaviour(RevertStrings _revertStrings)
 {
-	if (m_stackState >= ParsedAndImported)
-		solThrow(CompilerError, "Must set revert string settings before parsing.");
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set revert string settings before compiling.");
 	solUnimplementedAssert(_revertStrings != RevertStrings::VerboseDebug);
 	m_revertStrings = _revertStrings;
 }
 
 void CompilerStack::useMetadataLiteralSources(bool _metadataLiteralSources)
 {
-	if (m_stackState >= ParsedAndImported)
-		solThrow(CompilerError, "Must set use literal sources before parsing.");
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set use literal sources before compiling.");
 	m_metadataLiteralSources = _metadataLiteralSources;
 }
 
 void CompilerStack::setMetadataHash(MetadataHash _metadataHash)
 {
-	if (m_stackState >= ParsedAndImported)
-		solThrow(CompilerError, "Must set metadata hash before parsing.");
+	if (m_stackState >= CompilationSuccessful)
+		solThrow(CompilerError, "Must set metadata hash before compiling.");
 	m_metadataHash = _metadataHash;
 }
 
@@ -319,6 +325,8 @@ void CompilerStack::reset(bool _keepSettings)
 		m_evmVersion = langutil::EVMVersion();
 		m_modelCheckerSettings = ModelCheckerSettings{};
 		m_generateIR = false;
+		m_profileOptimiser = false;
+		m_parallelJobs = 1;
 		m_revertStrings = RevertStrings::Default;
 		m_optimiserSettings = OptimiserSettings::minimal();
 		m_metadataLiteralSources = false;
@@ -329,7 +337,9 @@ void CompilerStack::reset(bool _keepSettings)
 	m_globalContext.reset();
 	m_sourceOrder.clear();
 	m_contracts.clear();
+	m_optimizedCodeCache.reset();
 	m_errorReporter.clear();
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	TypeProvider::reset();
 }
 
@@ -346,6 +356,7 @@ void CompilerStack::setSources(StringMap _sources)
 
 bool CompilerStack::parse()
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState != SourcesSet)
 		solThrow(CompilerError, "Must call parse only after the SourcesSet state.");
 	m_errorReporter.clear();
@@ -417,6 +428,7 @@ bool CompilerStack::parse()
 
 void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState != Empty)
 		solThrow(CompilerError, "Must call importASTs only before the SourcesSet state.");
 	map<string, ASTPointer<SourceUnit>> reconstructedSources = ASTJsonImporter(m_evmVersion).jsonToSourceUnit(_sources);
@@ -440,6 +452,7 @@ void CompilerStack::importASTs(map<string, Json::Value> const& _sources)
 
 bool CompilerStack::analyze()
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState != ParsedAndImported || m_stackState >= AnalysisPerformed)
 		solThrow(CompilerError, "Must call analyze only after parsing was performed.");
 
@@ -629,6 +642,7 @@ bool CompilerStack::analyze()
 	}
 
 	m_stackState = AnalysisPerformed;
+	m_analysisErrorCount = m_errorList.size();
 	if (!noErrors)
 		m_hasError = true;
 
@@ -674,6 +688,7 @@ bool CompilerStack::isRequestedContract(ContractDefinition const& _contract) con
 
 bool CompilerStack::compile(State _stopAfter)
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	m_stopAfter = _stopAfter;
 	if (m_stackState < AnalysisPerformed)
 		if (!parseAndAnalyze(_stopAfter))
@@ -685,62 +700,235 @@ bool CompilerStack::compile(State _stopAfter)
 	if (m_hasError)
 		solThrow(CompilerError, "Called compile with errors.");
 
-	// Only compile contracts individually which have been requested.
-	map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+	m_optimizedCodeCache = make_shared<yul::OptimizedCodeCache>();
 
+	// Only compile contracts individually which have been requested.
+	vector<ContractDefinition const*> requestedContracts;
 	for (Source const* source: m_sourceOrder)
 		for (ASTPointer<ASTNode> const& node: source->ast->nodes())
 			if (auto contract = dynamic_cast<ContractDefinition const*>(node.get()))
 				if (isRequestedContract(*contract))
+					requestedContracts.push_back(contract);
+
+	if (m_parallelJobs > 1 && (m_viaIR || !m_generateEvmBytecode))
+	{
+		if (!generateCodeInParallel(requestedContracts))
+			return false;
+	}
+	else
+	{
+		// generateIR also optimizes the IR of the contracts created by the requested ones.
+		if (m_viaIR || m_generateIR)
+		{
+			vector<ContractDefinition const*> optimizedContracts;
+			set<ContractDefinition const*, ASTNode::CompareByID> visitedContracts;
+			function<void(ContractDefinition const&)> visit = [&](ContractDefinition const& _contract)
+			{
+				if (!visitedContracts.insert(&_contract).second)
+					return;
+				for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+					visit(*dependency);
+				optimizedContracts.push_back(&_contract);
+			};
+			for (ContractDefinition const* contract: requestedContracts)
+				visit(*contract);
+			countIRObjectUses(optimizedContracts);
+		}
+
+		map<ContractDefinition const*, shared_ptr<Compiler const>> otherCompilers;
+		for (ContractDefinition const* contract: requestedContracts)
+			try
+			{
+				if (m_viaIR || m_generateIR)
+					generateIR(*contract);
+				if (m_generateEvmBytecode)
 				{
-					try
-					{
-						if (m_viaIR || m_generateIR)
-							generateIR(*contract);
-						if (m_generateEvmBytecode)
-						{
-							if (m_viaIR)
-								generateEVMFromIR(*contract);
-							else
-								compileContract(*contract, otherCompilers);
-						}
-					}
-					catch (Error const& _error)
-					{
-						if (_error.type() != Error::Type::CodeGenerationError)
-							throw;
-						m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
-						return false;
-					}
-					catch (UnimplementedFeatureError const& _unimplementedError)
-					{
-						if (
-							SourceLocation const* sourceLocation =
-							boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError)
-						)
-						{
-							string const* comment = _unimplementedError.comment();
-							m_errorReporter.error(
-								1834_error,
-								Error::Type::CodeGenerationError,
-								*sourceLocation,
-								fmt::format(
-									"Unimplemented feature error {} in {}",
-									(comment && !comment->empty()) ? ": " + *comment : "",
-									_unimplementedError.lineInfo()
-								)
-							);
-							return false;
-						}
-						else
-							throw;
-					}
+					if (m_viaIR)
+						generateEVMFromIR(*contract, m_errorReporter);
+					else
+						compileContract(*contract, otherCompilers);
 				}
+			}
+			catch (...)
+			{
+				reportCodegenError(current_exception());
+				return false;
+			}
+	}
 	m_stackState = CompilationSuccessful;
 	this->link();
 	return true;
 }
 
+void CompilerStack::resetCodeGeneration()
+{
+	if (m_stackState < AnalysisPerformed)
+		solThrow(CompilerError, "Must call resetCodeGeneration only after analysis was performed.");
+
+	for (auto& [name, contract]: m_contracts)
+	{
+		contract.compiler.reset();
+		contract.evmAssembly.reset();
+		contract.evmRuntimeAssembly.reset();
+		contract.object = {};
+		contract.runtimeObject = {};
+		contract.yulIR.clear();
+		contract.yulIRWithPlaceholders.clear();
+		contract.yulIRObject.reset();
+		contract.yulIRObjectUses = 0;
+		contract.yulIRPlaceholderLayout.reset();
+		contract.yulIROptimizedStack.reset();
+		contract.yulIROptimized.reset();
+		contract.yulIRAst.reset();
+		contract.yulIROptimizedAst.reset();
+		contract.optimiserProfile.reset();
+		contract.metadata.reset();
+		contract.generatedSources.reset();
+		contract.runtimeGeneratedSources.reset();
+		contract.sourceMapping.reset();
+		contract.runtimeSourceMapping.reset();
+	}
+	m_optimizedCodeCache.reset();
+	solAssert(m_errorList.size() >= m_analysisErrorCount);
+	m_errorList.resize(m_analysisErrorCount);
+	m_stackState = AnalysisPerformed;
+}
+
+bool CompilerStack::generateCodeInParallel(vector<ContractDefinition const*> const& _contracts)
+{
+	solAssert(m_viaIR || !m_generateEvmBytecode);
+
+	// IR generation walks the Solidity AST and the type system, which are not thread-safe,
+	// so it stays sequential. Contract dependencies are resolved recursively here, which means
+	// that afterwards every contract can be optimized and assembled independently.
+	// We remember where the errors of each contract end, so that the errors reported during
+	// the concurrent part can be put back in the order of the sequential pipeline.
+	size_t const initialErrorCount = m_errorList.size();
+	vector<size_t> irErrorsEnd;
+	exception_ptr irGenerationFailure;
+	for (ContractDefinition const* contract: _contracts)
+	{
+		try
+		{
+			if (m_viaIR || m_generateIR)
+				generateIR(*contract, /* _deferYulOptimization */ true);
+		}
+		catch (...)
+		{
+			irGenerationFailure = current_exception();
+			break;
+		}
+		irErrorsEnd.push_back(m_errorList.size());
+	}
+
+	// Parsing the IR of a contract does not depend on other contracts, so the IR of all contracts
+	// used by the optimization, including the ones that are only compiled as dependencies, is parsed
+	// before the optimization combines it with the objects of the contracts it creates.
+	countIRObjectUses({_contracts.begin(), _contracts.begin() + static_cast<ptrdiff_t>(irErrorsEnd.size())});
+	vector<ContractDefinition const*> contractsToParse;
+	for (auto const& [name, contract]: m_contracts)
+		if (contract.yulIRObjectUses > 0 && !contract.yulIRObject)
+			contractsToParse.push_back(contract.contract);
+	vector<exception_ptr> parseFailures(contractsToParse.size());
+	util::parallelFor(m_parallelJobs, contractsToParse.size(), [&](size_t _index) {
+		try
+		{
+			parseIR(*contractsToParse[_index]);
+		}
+		catch (...)
+		{
+			parseFailures[_index] = current_exception();
+		}
+	});
+	// The IR is generated by the compiler, so it failing to parse is an internal error.
+	for (exception_ptr const& failure: parseFailures)
+		if (failure)
+			rethrow_exception(failure);
+
+	// Only contracts preceding a failure would have been compiled by the sequential pipeline.
+	size_t const contractCount = irErrorsEnd.size();
+	vector<ErrorList> codegenErrors(contractCount);
+	vector<exception_ptr> codegenFailures(contractCount);
+	// Threads that are not needed for the contracts are shared out to optimise their functions.
+	size_t const optimiserJobs = contractCount > 0 ? max<size_t>(1, m_parallelJobs / contractCount) : 1;
+	util::parallelFor(m_parallelJobs, contractCount, [&](size_t _index) {
+		TypeProvider::Scope typeProviderScope{*m_typeProvider};
+		ContractDefinition const& contract = *_contracts[_index];
+		ErrorReporter errorReporter(codegenErrors[_index]);
+		try
+		{
+			if (m_viaIR || m_generateIR)
+				optimizeIR(contract, optimiserJobs);
+			if (m_generateEvmBytecode)
+				generateEVMFromIR(contract, errorReporter);
+		}
+		catch (...)
+		{
+			codegenFailures[_index] = current_exception();
+		}
+	});
+
+	ErrorList irErrors;
+	irErrors.swap(m_errorList);
+	m_errorList.assign(irErrors.begin(), irErrors.begin() + static_cast<ptrdiff_t>(initialErrorCount));
+	size_t irErrorsBegin = initialErrorCount;
+	for (size_t index = 0; index < contractCount; ++index)
+	{
+		m_errorList.insert(
+			m_errorList.end(),
+			irErrors.begin() + static_cast<ptrdiff_t>(irErrorsBegin),
+			irErrors.begin() + static_cast<ptrdiff_t>(irErrorsEnd[index])
+		);
+		irErrorsBegin = irErrorsEnd[index];
+		m_errorReporter.append(codegenErrors[index]);
+		if (codegenFailures[index])
+		{
+			reportCodegenError(codegenFailures[index]);
+			return false;
+		}
+	}
+	m_errorList.insert(m_errorList.end(), irErrors.begin() + static_cast<ptrdiff_t>(irErrorsBegin), irErrors.end());
+
+	if (irGenerationFailure)
+	{
+		reportCodegenError(irGenerationFailure);
+		return false;
+	}
+	return true;
+}
+
+void CompilerStack::reportCodegenError(exception_ptr _exception)
+{
+	try
+	{
+		rethrow_exception(_exception);
+	}
+	catch (Error const& _error)
+	{
+		if (_error.type() != Error::Type::CodeGenerationError)
+			throw;
+		m_errorReporter.error(_error.errorId(), _error.type(), SourceLocation(), _error.what());
+	}
+	catch (UnimplementedFeatureError const& _unimplementedError)
+	{
+		SourceLocation const* sourceLocation =
+			boost::get_error_info<langutil::errinfo_sourceLocation>(_unimplementedError);
+		if (!sourceLocation)
+			throw;
+		string const* comment = _unimplementedError.comment();
+		m_errorReporter.error(
+			1834_error,
+			Error::Type::CodeGenerationError,
+			*sourceLocation,
+			fmt::format(
+				"Unimplemented feature error {} in {}",
+				(comment && !comment->empty()) ? ": " + *comment : "",
+				_unimplementedError.lineInfo()
+			)
+		);
+	}
+}
+
 void CompilerStack::link()
 {
 	solAssert(m_stackState >= CompilationSuccessful, "");
@@ -896,12 +1084,166 @@ string const& CompilerStack::yulIR(string const& _contractName) const
 	return contract(_contractName).yulIR;
 }
 
+namespace
+{
+
+/// @returns the offset of the first character of each non-empty line of IR formatted by yul::reindent.
+vector<int> irLineStarts(string const& _ir)
+{
+	vector<int> lineStarts;
+	size_t lineStart = 0;
+	while (lineStart < _ir.size())
+	{
+		size_t lineEnd = min(_ir.find('\n', lineStart), _ir.size());
+		size_t firstCharacter = _ir.find_first_not_of(' ', lineStart);
+		if (firstCharacter < lineEnd)
+			lineStarts.push_back(static_cast<int>(firstCharacter));
+		lineStart = lineEnd + 1;
+	}
+	return lineStarts;
+}
+
+/// @returns the index of the non-empty line containing @a _offset.
+size_t irLineIndex(vector<int> const& _lineStarts, int _offset)
+{
+	auto nextLine = upper_bound(_lineStarts.begin(), _lineStarts.end(), _offset);
+	solAssert(nextLine != _lineStarts.begin());
+	return static_cast<size_t>(nextLine - _lineStarts.begin()) - 1;
+}
+
+/**
+ * Moves the native source locations of the nodes in an AST from one IR text to another one, whose
+ * non-empty lines are the same apart from their indentation. Lines of the first text map to
+ * lines of the second one as given by a function.
+ */
+class NativeLocationMover: public yul::ASTModifier
+{
+public:
+	NativeLocationMover(
+		vector<int> const& _fromLineStarts,
+		vector<int> const& _toLineStarts,
+		function<size_t(size_t)> _mapLine
+	):
+		m_fromLineStarts(_fromLineStarts),
+		m_toLineStarts(_toLineStarts),
+		m_mapLine(std::move(_mapLine))
+	{}
+
+	/// Moves the locations in the code of @a _object and of all its sub-objects.
+	void moveObject(yul::Object& _object)
+	{
+		(*this)(*_object.code);
+		for (shared_ptr<yul::ObjectNode> const& subNode: _object.subObjects)
+			if (auto subObject = dynamic_cast<yul::Object*>(subNode.get()))
+				moveObject(*subObject);
+	}
+
+	using ASTModifier::operator();
+	void operator()(yul::Literal& _literal) override { move(_literal.debugData); }
+	void operator()(yul::Identifier& _identifier) override { move(_identifier.debugData); }
+	void operator()(yul::FunctionCall& _call) override
+	{
+		move(_call.debugData);
+		move(_call.functionName.debugData);
+		ASTModifier::operator()(_call);
+	}
+	void operator()(yul::ExpressionStatement& _statement) override
+	{
+		move(_statement.debugData);
+		ASTModifier::operator()(_statement);
+	}
+	void operator()(yul::Assignment& _assignment) override
+	{
+		move(_assignment.debugData);
+		ASTModifier::operator()(_assignment);
+	}
+	void operator()(yul::VariableDeclaration& _declaration) override
+	{
+		move(_declaration.debugData);
+		for (yul::TypedName& variable: _declaration.variables)
+			move(variable.debugData);
+		ASTModifier::operator()(_declaration);
+	}
+	void operator()(yul::If& _if) override
+	{
+		move(_if.debugData);
+		ASTModifier::operator()(_if);
+	}
+	void operator()(yul::Switch& _switch) override
+	{
+		move(_switch.debugData);
+		for (yul::Case& switchCase: _switch.cases)
+			move(switchCase.debugData);
+		ASTModifier::operator()(_switch);
+	}
+	void operator()(yul::FunctionDefinition& _function) override
+	{
+		move(_function.debugData);
+		for (yul::TypedName& parameter: _function.parameters)
+			move(parameter.debugData);
+		for (yul::TypedName& returnVariable: _function.returnVariables)
+			move(returnVariable.debugData);
+		ASTModifier::operator()(_function);
+	}
+	void operator()(yul::ForLoop& _loop) override
+	{
+		move(_loop.debugData);
+		ASTModifier::operator()(_loop);
+	}
+	void operator()(yul::Break& _break) override { move(_break.debugData); }
+	void operator()(yul::Continue& _continue) override { move(_continue.debugData); }
+	void operator()(yul::Leave& _leave) override { move(_leave.debugData); }
+	void operator()(yul::Block& _block) override
+	{
+		move(_block.debugData);
+		ASTModifier::operator()(_block);
+	}
+
+private:
+	/// Replaces @a _debugData by a copy with the moved native location. Debug data is shared
+	/// between nodes, so each one is only copied once.
+	void move(shared_ptr<yul::DebugData const>& _debugData)
+	{
+		if (!_debugData || _debugData->nativeLocation.start < 0 || _debugData->nativeLocation.end < 0)
+			return;
+		shared_ptr<yul::DebugData const>& moved = m_movedDebugData[_debugData];
+		if (!moved)
+		{
+			SourceLocation location = _debugData->nativeLocation;
+			location.start = moveOffset(location.start);
+			location.end = moveOffset(location.end);
+			moved = yul::DebugData::create(std::move(location), _debugData->originLocation, _debugData->astID);
+		}
+		_debugData = moved;
+	}
+
+	int moveOffset(int _offset) const
+	{
+		size_t const line = irLineIndex(m_fromLineStarts, _offset);
+		size_t const movedLine = m_mapLine(line);
+		solAssert(movedLine < m_toLineStarts.size());
+		return m_toLineStarts[movedLine] + (_offset - m_fromLineStarts[line]);
+	}
+
+	vector<int> const& m_fromLineStarts;
+	vector<int> const& m_toLineStarts;
+	function<size_t(size_t)> m_mapLine;
+	map<shared_ptr<yul::DebugData const>, shared_ptr<yul::DebugData const>> m_movedDebugData;
+};
+
+}
+
 Json::Value const& CompilerStack::yulIRAst(string const& _contractName) const
 {
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).yulIRAst;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIRAst.init([&]{
+		if (compiledContract.yulIR.empty())
+			return Json::Value{};
+		return loadGeneratedIR(compiledContract.yulIR)->astJson();
+	});
 }
 
 string const& CompilerStack::yulIROptimized(string const& _contractName) const
@@ -909,7 +1251,12 @@ string const& CompilerStack::yulIROptimized(string const& _contractName) const
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).yulIROptimized;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIROptimized.init([&]{
+		if (!compiledContract.yulIROptimizedStack)
+			return string{};
+		return compiledContract.yulIROptimizedStack->print(this);
+	});
 }
 
 Json::Value const& CompilerStack::yulIROptimizedAst(string const& _contractName) const
@@ -917,7 +1264,29 @@ Json::Value const& CompilerStack::yulIROptimizedAst(string const& _contractName)
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
-	return contract(_contractName).yulIROptimizedAst;
+	Contract const& compiledContract = contract(_contractName);
+	return compiledContract.yulIROptimizedAst.init([&]{
+		if (!compiledContract.yulIROptimizedStack)
+			return Json::Value{};
+		if (!compiledContract.yulIRPlaceholderLayout)
+			return compiledContract.yulIROptimizedStack->astJson();
+		// The objects of the contract and of the contracts it creates were parsed separately,
+		// so the locations are changed to be the same as if the object was parsed from yulIR.
+		shared_ptr<yul::Object> object = compiledContract.yulIROptimizedStack->parserResult()->clone();
+		mapNativeLocationsToIR(*object, *compiledContract.contract);
+		return object->toJson();
+	});
+}
+
+Json::Value CompilerStack::optimiserProfile(string const& _contractName) const
+{
+	if (m_stackState != CompilationSuccessful)
+		solThrow(CompilerError, "Compilation was not successful.");
+
+	Contract const& compiledContract = contract(_contractName);
+	if (!compiledContract.optimiserProfile)
+		return Json::Value{};
+	return compiledContract.optimiserProfile->toJson();
 }
 
 evmasm::LinkerObject const& CompilerStack::object(string const& _contractName) const
@@ -988,6 +1357,7 @@ Json::Value const& CompilerStack::contractABI(string const& _contractName) const
 
 Json::Value const& CompilerStack::contractABI(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1006,6 +1376,7 @@ Json::Value const& CompilerStack::storageLayout(string const& _contractName) con
 
 Json::Value const& CompilerStack::storageLayout(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1024,6 +1395,7 @@ Json::Value const& CompilerStack::natspecUser(string const& _contractName) const
 
 Json::Value const& CompilerStack::natspecUser(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1042,6 +1414,7 @@ Json::Value const& CompilerStack::natspecDev(string const& _contractName) const
 
 Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1052,6 +1425,7 @@ Json::Value const& CompilerStack::natspecDev(Contract const& _contract) const
 
 Json::Value CompilerStack::interfaceSymbols(string const& _contractName) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1082,6 +1456,7 @@ Json::Value CompilerStack::interfaceSymbols(string const& _contractName) const
 
 bytes CompilerStack::cborMetadata(string const& _contractName, bool _forIR) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1090,6 +1465,7 @@ bytes CompilerStack::cborMetadata(string const& _contractName, bool _forIR) cons
 
 string const& CompilerStack::metadata(Contract const& _contract) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState < AnalysisPerformed)
 		solThrow(CompilerError, "Analysis was not successful.");
 
@@ -1323,7 +1699,8 @@ bool onlySafeExperimentalFeaturesActivated(set<ExperimentalFeature> const& featu
 void CompilerStack::assembleYul(
 	ContractDefinition const& _contract,
 	shared_ptr<evmasm::Assembly> _assembly,
-	shared_ptr<evmasm::Assembly> _runtimeAssembly
+	shared_ptr<evmasm::Assembly> _runtimeAssembly,
+	ErrorReporter& _errorReporter
 )
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
@@ -1363,7 +1740,7 @@ void CompilerStack::assembleYul(
 		m_evmVersion >= langutil::EVMVersion::spuriousDragon() &&
 		compiledContract.runtimeObject.bytecode.size() > 0x6000
 	)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			5574_error,
 			_contract.location(),
 			"Contract code size is "s +
@@ -1381,7 +1758,7 @@ void CompilerStack::assembleYul(
 		m_evmVersion >= langutil::EVMVersion::shanghai() &&
 		compiledContract.object.bytecode.size() > 0xC000
 	)
-		m_errorReporter.warning(
+		_errorReporter.warning(
 			3860_error,
 			_contract.location(),
 			"Contract initcode size is "s +
@@ -1415,7 +1792,7 @@ void CompilerStack::compileContract(
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
 
-	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings);
+	shared_ptr<Compiler> compiler = make_shared<Compiler>(m_evmVersion, m_revertStrings, m_optimiserSettings, m_parallelJobs);
 	compiledContract.compiler = compiler;
 
 	solAssert(!m_viaIR, "");
@@ -1433,10 +1810,10 @@ void CompilerStack::compileContract(
 
 	_otherCompilers[compiledContract.contract] = compiler;
 
-	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr());
+	assembleYul(_contract, compiler->assemblyPtr(), compiler->runtimeAssemblyPtr(), m_errorReporter);
 }
 
-void CompilerStack::generateIR(ContractDefinition const& _contract)
+void CompilerStack::generateIR(ContractDefinition const& _contract, bool _deferYulOptimization)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 	if (m_hasError)
@@ -1456,7 +1833,7 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 
 	string dependenciesSource;
 	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
-		generateIR(*dependency);
+		generateIR(*dependency, _deferYulOptimization);
 
 	if (!_contract.canBeDeployed())
 		return;
@@ -1473,12 +1850,59 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		m_debugInfoSelection,
 		this
 	);
-	compiledContract.yulIR = generator.run(
+	tie(compiledContract.yulIR, compiledContract.yulIRWithPlaceholders) = generator.run(
 		_contract,
 		createCBORMetadata(compiledContract, /* _forIR */ true),
 		otherYulSources
 	);
 
+	if (!_deferYulOptimization)
+	{
+		parseIR(_contract);
+		optimizeIR(_contract);
+	}
+}
+
+void CompilerStack::countIRObjectUses(vector<ContractDefinition const*> const& _contracts)
+{
+	for (ContractDefinition const* contract: _contracts)
+	{
+		if (!contract->canBeDeployed() || m_contracts.at(contract->fullyQualifiedName()).yulIROptimizedStack)
+			continue;
+
+		// buildIRObject uses the object of the contract and of each contract it creates,
+		// directly or indirectly, once.
+		set<ContractDefinition const*, ASTNode::CompareByID> usedContracts;
+		function<void(ContractDefinition const&)> collect = [&](ContractDefinition const& _contract)
+		{
+			if (usedContracts.insert(&_contract).second)
+				for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+					collect(*dependency);
+		};
+		collect(*contract);
+		for (ContractDefinition const* usedContract: usedContracts)
+			++m_contracts.at(usedContract->fullyQualifiedName()).yulIRObjectUses;
+	}
+}
+
+void CompilerStack::parseIR(ContractDefinition const& _contract)
+{
+	solAssert(m_stackState >= AnalysisPerformed, "");
+	if (m_hasError)
+		solThrow(CompilerError, "Called parseIR with errors.");
+
+	if (!_contract.canBeDeployed())
+		return;
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	if (compiledContract.yulIRObject || compiledContract.yulIRObjectUses == 0)
+		return;
+	solAssert(!compiledContract.yulIR.empty(), "");
+	// Without created contracts there are no placeholders and the IR is parsed as is.
+	string const& ir = compiledContract.yulIRWithPlaceholders.empty() ?
+		compiledContract.yulIR :
+		compiledContract.yulIRWithPlaceholders;
+
 	yul::YulStack stack(
 		m_evmVersion,
 		m_eofVersion,
@@ -1486,7 +1910,8 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 		m_optimiserSettings,
 		m_debugInfoSelection
 	);
-	if (!stack.parseAndAnalyze("", compiledContract.yulIR))
+	shared_ptr<yul::Object> object = stack.parse("", ir);
+	if (!object)
 	{
 		string errorMessage;
 		for (auto const& error: stack.errors())
@@ -1494,46 +1919,243 @@ void CompilerStack::generateIR(ContractDefinition const& _contract)
 				*error,
 				stack.charStream("")
 			);
-		solAssert(false, compiledContract.yulIR + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
+		solAssert(false, ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
 	}
+	if (!compiledContract.yulIRWithPlaceholders.empty())
+	{
+		map<yul::YulString, ContractDefinition const*> createdContracts;
+		for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+			createdContracts.emplace(IRNames::creationObject(*dependency), dependency);
 
-	compiledContract.yulIRAst = stack.astJson();
-	stack.optimize();
-	compiledContract.yulIROptimized = stack.print(this);
-	compiledContract.yulIROptimizedAst = stack.astJson();
+		IRPlaceholderLayout layout;
+		layout.lineStarts = irLineStarts(ir);
+		function<void(yul::Object const&)> findPlaceholders = [&](yul::Object const& _object)
+		{
+			for (shared_ptr<yul::ObjectNode> const& subNode: _object.subObjects)
+				if (auto subObject = dynamic_cast<yul::Object const*>(subNode.get()))
+				{
+					auto createdContract = createdContracts.find(subObject->name);
+					if (createdContract == createdContracts.end())
+						findPlaceholders(*subObject);
+					else
+						layout.placeholders.emplace_back(
+							irLineIndex(layout.lineStarts, subObject->code->debugData->nativeLocation.start),
+							createdContract->second
+						);
+				}
+		};
+		findPlaceholders(*object);
+		compiledContract.yulIRPlaceholderLayout = std::move(layout);
+	}
+	compiledContract.yulIRObject = std::move(object);
+	compiledContract.yulIRWithPlaceholders.clear();
 }
 
-void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract)
+void CompilerStack::optimizeIR(ContractDefinition const& _contract, size_t _jobs)
 {
 	solAssert(m_stackState >= AnalysisPerformed, "");
 	if (m_hasError)
-		solThrow(CompilerError, "Called generateEVMFromIR with errors.");
+		solThrow(CompilerError, "Called optimizeIR with errors.");
 
 	if (!_contract.canBeDeployed())
 		return;
 
 	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
-	solAssert(!compiledContract.yulIROptimized.empty(), "");
-	if (!compiledContract.object.bytecode.empty())
+	if (compiledContract.yulIROptimizedStack)
 		return;
 
-	// Re-parse the Yul IR in EVM dialect
-	yul::YulStack stack(
+	auto stack = make_shared<yul::YulStack>(
 		m_evmVersion,
 		m_eofVersion,
 		yul::YulStack::Language::StrictAssembly,
 		m_optimiserSettings,
-		m_debugInfoSelection
+		m_debugInfoSelection,
+		m_optimizedCodeCache
 	);
-	bool analysisSuccessful = stack.parseAndAnalyze("", compiledContract.yulIROptimized);
-	solAssert(analysisSuccessful);
+	shared_ptr<yul::Object> object;
+	{
+		map<ContractDefinition const*, shared_ptr<yul::Object const>> builtObjects;
+		object = buildIRObject(_contract, builtObjects);
+	}
+	// The objects of the created contracts were parsed on their own and are not part of the
+	// parsed text, so the errors are reported without source excerpts.
+	if (!stack->analyze(std::move(object)))
+	{
+		string errorMessage;
+		for (auto const& error: stack->errors())
+			errorMessage += Error::formatErrorType(error->type()) + ": " + error->what() + "\n";
+		solAssert(false, compiledContract.yulIR + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
+	}
+	if (m_profileOptimiser)
+		compiledContract.optimiserProfile = make_shared<yul::OptimiserProfile>();
+	stack->optimize(compiledContract.optimiserProfile.get(), _jobs);
+	// The optimized IR text and the JSON ASTs are only produced on request. The IR generator
+	// only emits the debug data selected in m_debugInfoSelection, so the optimized AST carries
+	// the same debug data as its printed form would and can be assembled directly.
+	compiledContract.yulIROptimizedStack = std::move(stack);
+}
 
-	//cout << yul::AsmPrinter{}(*stack.parserResult()->code) << endl;
+shared_ptr<yul::Object> CompilerStack::buildIRObject(
+	ContractDefinition const& _contract,
+	map<ContractDefinition const*, shared_ptr<yul::Object const>>& _builtObjects
+)
+{
+	if (auto builtObject = _builtObjects.find(&_contract); builtObject != _builtObjects.end())
+		return builtObject->second->clone();
+
+	map<yul::YulString, ContractDefinition const*> createdContracts;
+	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+		createdContracts.emplace(IRNames::creationObject(*dependency), dependency);
+
+	shared_ptr<yul::Object> object = useIRObject(m_contracts.at(_contract.fullyQualifiedName()));
+	function<void(yul::Object&)> replacePlaceholders = [&](yul::Object& _object)
+	{
+		for (shared_ptr<yul::ObjectNode>& subNode: _object.subObjects)
+			if (auto subObject = dynamic_cast<yul::Object*>(subNode.get()))
+			{
+				auto createdContract = createdContracts.find(subObject->name);
+				if (createdContract == createdContracts.end())
+					replacePlaceholders(*subObject);
+				else
+				{
+					solAssert(subObject->code->statements.empty() && subObject->subObjects.empty(), "");
+					subNode = buildIRObject(*createdContract->second, _builtObjects);
+				}
+			}
+	};
+	replacePlaceholders(*object);
+	_builtObjects[&_contract] = object;
+	return object;
+}
+
+shared_ptr<yul::Object> CompilerStack::useIRObject(Contract& _compiledContract)
+{
+	shared_ptr<yul::Object const> object;
+	{
+		lock_guard<mutex> lock(m_irObjectsMutex);
+		solAssert(_compiledContract.yulIRObject && _compiledContract.yulIRObjectUses > 0, "");
+		object = _compiledContract.yulIRObject;
+		// Uses still in progress are counted until their copy is made, so nobody else needs the
+		// object after the last use, which can take it without copying.
+		if (_compiledContract.yulIRObjectUses == 1)
+		{
+			_compiledContract.yulIRObjectUses = 0;
+			_compiledContract.yulIRObject.reset();
+			return const_pointer_cast<yul::Object>(object);
+		}
+	}
+	shared_ptr<yul::Object> copy = object->clone();
+	lock_guard<mutex> lock(m_irObjectsMutex);
+	if (--_compiledContract.yulIRObjectUses == 0)
+		_compiledContract.yulIRObject.reset();
+	return copy;
+}
+
+void CompilerStack::mapNativeLocationsToIR(yul::Object& _object, ContractDefinition const& _contract) const
+{
+	Contract const& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	// Without placeholders the object was parsed from yulIR.
+	if (!compiledContract.yulIRPlaceholderLayout)
+		return;
+	IRPlaceholderLayout const& layout = *compiledContract.yulIRPlaceholderLayout;
+	vector<int> const lineStarts = irLineStarts(compiledContract.yulIR);
+
+	map<yul::YulString, ContractDefinition const*> createdContracts;
+	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+		createdContracts.emplace(IRNames::creationObject(*dependency), dependency);
+
+	// In yulIR, each placeholder line is replaced by the non-empty lines of the IR of the created
+	// contract, so the lines following it move down by the number of lines added.
+	vector<size_t> firstLines;
+	vector<size_t> addedLines;
+	for (auto const& [line, createdContract]: layout.placeholders)
+	{
+		size_t const added = addedLines.empty() ? 0 : addedLines.back();
+		firstLines.push_back(line + added);
+		addedLines.push_back(
+			added + irLineStarts(m_contracts.at(createdContract->fullyQualifiedName()).yulIR).size() - 1
+		);
+	}
+	NativeLocationMover ownLocations(layout.lineStarts, lineStarts, [&](size_t _line) {
+		size_t placeholdersBefore = 0;
+		while (placeholdersBefore < layout.placeholders.size() && layout.placeholders[placeholdersBefore].first < _line)
+			++placeholdersBefore;
+		return placeholdersBefore == 0 ? _line : _line + addedLines[placeholdersBefore - 1];
+	});
+
+	size_t placeholderIndex = 0;
+	function<void(yul::Object&)> mapObject = [&](yul::Object& _object)
+	{
+		ownLocations(*_object.code);
+		for (shared_ptr<yul::ObjectNode>& subNode: _object.subObjects)
+			if (auto subObject = dynamic_cast<yul::Object*>(subNode.get()))
+			{
+				auto createdContract = createdContracts.find(subObject->name);
+				if (createdContract == createdContracts.end())
+				{
+					mapObject(*subObject);
+					continue;
+				}
+				solAssert(placeholderIndex < layout.placeholders.size());
+				solAssert(layout.placeholders[placeholderIndex].second == createdContract->second);
+				mapNativeLocationsToIR(*subObject, *createdContract->second);
+				size_t const firstLine = firstLines[placeholderIndex++];
+				vector<int> const embeddedLineStarts =
+					irLineStarts(m_contracts.at(createdContract->second->fullyQualifiedName()).yulIR);
+				NativeLocationMover embeddedLocations(
+					embeddedLineStarts,
+					lineStarts,
+					[&](size_t _line) { return firstLine + _line; }
+				);
+				embeddedLocations.moveObject(*subObject);
+			}
+	};
+	mapObject(_object);
+	solAssert(placeholderIndex == layout.placeholders.size());
+}
+
+shared_ptr<yul::YulStack> CompilerStack::loadGeneratedIR(string const& _ir) const
+{
+	auto stack = make_shared<yul::YulStack>(
+		m_evmVersion,
+		m_eofVersion,
+		yul::YulStack::Language::StrictAssembly,
+		m_optimiserSettings,
+		m_debugInfoSelection,
+		m_optimizedCodeCache
+	);
+	if (!stack->parseAndAnalyze("", _ir))
+	{
+		string errorMessage;
+		for (auto const& error: stack->errors())
+			errorMessage += langutil::SourceReferenceFormatter::formatErrorInformation(
+				*error,
+				stack->charStream("")
+			);
+		solAssert(false, _ir + "\n\nInvalid IR generated:\n" + errorMessage + "\n");
+	}
+	return stack;
+}
+
+void CompilerStack::generateEVMFromIR(ContractDefinition const& _contract, ErrorReporter& _errorReporter)
+{
+	solAssert(m_stackState >= AnalysisPerformed, "");
+	if (m_hasError)
+		solThrow(CompilerError, "Called generateEVMFromIR with errors.");
+
+	if (!_contract.canBeDeployed())
+		return;
+
+	Contract& compiledContract = m_contracts.at(_contract.fullyQualifiedName());
+	solAssert(compiledContract.yulIROptimizedStack, "");
+	if (!compiledContract.object.bytecode.empty())
+		return;
 
 	string deployedName = IRNames::deployedObject(_contract);
 	solAssert(!deployedName.empty(), "");
-	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) = stack.assembleEVMWithDeployed(deployedName);
-	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly);
+	tie(compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly) =
+		compiledContract.yulIROptimizedStack->assembleEVMWithDeployed(deployedName);
+	assembleYul(_contract, compiledContract.evmAssembly, compiledContract.evmRuntimeAssembly, _errorReporter);
 }
 
 CompilerStack::Contract const& CompilerStack::contract(string const& _contractName) const
@@ -1824,6 +2446,7 @@ Json::Value gasToJson(GasEstimator::GasConsumption const& _gas)
 
 Json::Value CompilerStack::gasEstimates(string const& _contractName) const
 {
+	TypeProvider::Scope typeProviderScope{*m_typeProvider};
 	if (m_stackState != CompilationSuccessful)
 		solThrow(CompilerError, "Compilation was not successful.");
 
@@ -49,8 +49,10 @@
 
 #include <json/json.h>
 
+#include <exception>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <set>
 #include <string>
@@ -62,6 +64,14 @@ class CharStream;
 }
 
 
+namespace solidity::yul
+{
+class OptimizedCodeCache;
+class OptimiserProfile;
+class YulStack;
+struct Object;
+}
+
 namespace solidity::evmasm
 {
 class Assembly;
@@ -79,6 +89,7 @@ class FunctionDefinition;
 class SourceUnit;
 class Compiler;
 class GlobalContext;
+class TypeProvider;
 class Natspec;
 class DeclarationContainer;
 
@@ -86,8 +97,12 @@ class DeclarationContainer;
  * Easy to use and self-contained Solidity compiler with as few header dependencies as possible.
  * It holds state and can be used to either step through the compilation stages (and abort e.g.
  * before compilation to bytecode) or run the whole compilation in one call.
+ * Settings that only affect code generation can be changed after the analysis. Together with
+ * resetCodeGeneration(), this allows generating code for several settings from a single analysis.
  * If error recovery is active, it is possible to progress through the stages even when
  * there are errors. In any case, producing code is only possible without errors.
+ * Each compiler stack owns the types of its sources, so independent instances can be used
+ * concurrently on separate threads.
  */
 class CompilerStack: public langutil::CharStreamProvider
 {
@@ -141,6 +156,11 @@ public:
 
 	bool compilationSuccessful() const { return m_stackState >= CompilationSuccessful; }
 
+	/// @returns the type provider that owns the types of this compilation. Code that queries the
+	/// types of its AST outside of the functions of the compiler stack has to activate it with a
+	/// TypeProvider::Scope, otherwise new types end up in the process-wide default provider.
+	TypeProvider& typeProvider() const { return *m_typeProvider; }
+
 	/// Resets the compiler to an empty state. Unless @a _keepSettings is set to true,
 	/// all settings are reset as well.
 	void reset(bool _keepSettings = false);
@@ -150,18 +170,21 @@ public:
 	void setRemappings(std::vector<ImportRemapper::Remapping> _remappings);
 
 	/// Sets library addresses. Addresses are cleared iff @a _libraries is missing.
-	/// Must be set before parsing.
+	/// Must be set before compiling.
 	void setLibraries(std::map<std::string, util::h192> const& _libraries = {});
 
 	/// Changes the optimiser settings.
-	/// Must be set before parsing.
+	/// Must be set before compiling. Enabling or disabling the Yul optimiser affects the
+	/// analysis and must happen before parsing.
 	void setOptimiserSettings(bool _optimize, size_t _runs = OptimiserSettings{}.expectedExecutionsPerDeployment);
 
 	/// Changes the optimiser settings.
-	/// Must be set before parsing.
+	/// Must be set before compiling. Enabling or disabling the Yul optimiser affects the
+	/// analysis and must happen before parsing.
 	void setOptimiserSettings(OptimiserSettings _settings);
 
 	/// Sets whether to strip revert strings, add additional strings or do nothing at all.
+	/// Must be set before compiling.
 	void setRevertStringBehaviour(RevertStrings _revertStrings);
 
 	/// Set whether or not parser error is desired.
@@ -173,12 +196,12 @@ public:
 	}
 
 	/// Sets the pipeline to go through the Yul IR or not.
-	/// Must be set before parsing.
+	/// Must be set before compiling.
 	void setViaIR(bool _viaIR);
 
 	/// Set the EVM version used before running compile.
 	/// When called without an argument it will revert to the default version.
-	/// Must be set before parsing.
+	/// Must be set before parsing, because the analysis depends on the EVM version.
 	void setEVMVersion(langutil::EVMVersion _version = langutil::EVMVersion{});
 
 	/// Set the EOF version used before running compile.
@@ -203,13 +226,26 @@ public:
 	/// Enable generation of Yul IR code.
 	void enableIRGeneration(bool _enable = true) { m_generateIR = _enable; }
 
+	/// Enable recording the cost of the Yul optimiser steps run on the IR of each contract.
+	void enableOptimiserProfiling(bool _enable = true) { m_profileOptimiser = _enable; }
+
+	/// Sets the number of threads used to optimize the Yul IR and generate EVM code of
+	/// independent contracts concurrently. Threads that are not needed for the contracts are
+	/// used by the Yul optimiser to transform the functions of each contract concurrently.
+	/// IR generation itself and the legacy code generator
+	/// always run on a single thread. With the legacy code generator, the threads are used to
+	/// optimise the sub-assemblies of each contract concurrently instead.
+	/// The output does not depend on this setting. Must be set before compiling.
+	void setParallelJobs(size_t _jobs);
+
 	/// @arg _metadataLiteralSources When true, store sources as literals in the contract metadata.
-	/// Must be set before parsing.
+	/// Must be set before compiling.
 	void useMetadataLiteralSources(bool _metadataLiteralSources);
 
 	/// Sets whether and which hash should be used
 	/// to store the metadata in the bytecode.
 	/// @param _metadataHash can be IPFS, Bzzr1, None
+	/// Must be set before compiling.
 	void setMetadataHash(MetadataHash _metadataHash);
 
 	/// Select components of debug info that should be included in comments in generated assembly.
@@ -243,6 +279,12 @@ public:
 	/// @returns false on error.
 	bool compile(State _stopAfter = State::CompilationSuccessful);
 
+	/// Discards the results and errors of code generation while keeping the analyzed sources,
+	/// so that compile() can generate code again, e.g. with different optimiser settings.
+	/// This also discards the metadata, which depends on the settings.
+	/// Must be called after analysis.
+	void resetCodeGeneration();
+
 	/// @returns the list of sources (paths) used
 	std::vector<std::string> sourceNames() const;
 
@@ -285,6 +327,11 @@ public:
 	/// @returns the optimized IR representation of a contract AST in JSON format.
 	Json::Value const& yulIROptimizedAst(std::string const& _contractName) const;
 
+	/// @returns the cost of the Yul optimiser steps run on the IR of a contract in JSON format,
+	/// or null if optimiser profiling was not enabled or the IR was not optimized.
+	/// Objects whose optimized code was reused from another contract do not appear here.
+	Json::Value optimiserProfile(std::string const& _contractName) const;
+
 	/// @returns the assembled object for a contract.
 	evmasm::LinkerObject const& object(std::string const& _contractName) const;
 
@@ -375,6 +422,16 @@ private:
 		std::string const& ipfsUrl() const;
 	};
 
+	/// The layout of the IR of a contract with placeholders for the contracts it creates.
+	struct IRPlaceholderLayout
+	{
+		/// Offset of the first character of each non-empty line.
+		std::vector<int> lineStarts;
+		/// Index of the non-empty line of each placeholder and the contract replacing it, in the
+		/// order of the sub-objects.
+		std::vector<std::pair<size_t, ContractDefinition const*>> placeholders;
+	};
+
 	/// The state per contract. Filled gradually during compilation.
 	struct Contract
 	{
@@ -385,9 +442,25 @@ private:
 		evmasm::LinkerObject object; ///< Deployment object (includes the runtime sub-object).
 		evmasm::LinkerObject runtimeObject; ///< Runtime object.
 		std::string yulIR; ///< Yul IR code.
-		std::string yulIROptimized; ///< Optimized Yul IR code.
-		Json::Value yulIRAst; ///< JSON AST of Yul IR code.
-		Json::Value yulIROptimizedAst; ///< JSON AST of optimized Yul IR code.
+		/// Yul IR code with empty placeholders for the objects of the contracts it creates.
+		/// Empty if it does not create any contracts. Only kept until it is parsed into yulIRObject.
+		std::string yulIRWithPlaceholders;
+		/// Parsed but not analyzed yulIRWithPlaceholders (or yulIR). It is the basis of the object
+		/// optimized for this contract, and copies of it take the place of the placeholders in the
+		/// IR of the contracts creating this one. Freed after its last use.
+		std::shared_ptr<yul::Object const> yulIRObject;
+		/// Number of times yulIRObject will still be used by buildIRObject.
+		size_t yulIRObjectUses = 0;
+		/// Layout of yulIRWithPlaceholders, to which the native source locations of yulIRObject refer.
+		/// Set by parseIR if the contract creates contracts.
+		std::optional<IRPlaceholderLayout> yulIRPlaceholderLayout;
+		/// Optimized and analyzed Yul IR, from which the EVM code is generated.
+		std::shared_ptr<yul::YulStack> yulIROptimizedStack;
+		util::LazyInit<std::string const> yulIROptimized; ///< Optimized Yul IR code.
+		util::LazyInit<Json::Value const> yulIRAst; ///< JSON AST of Yul IR code.
+		util::LazyInit<Json::Value const> yulIROptimizedAst; ///< JSON AST of optimized Yul IR code.
+		/// Cost of the optimiser steps run on the IR, only recorded if requested.
+		std::shared_ptr<yul::OptimiserProfile> optimiserProfile;
 		util::LazyInit<std::string const> metadata; ///< The metadata json that will be hashed into the chain.
 		util::LazyInit<Json::Value const> abi;
 		util::LazyInit<Json::Value const> storageLayout;
@@ -423,10 +496,12 @@ private:
 
 	/// Assembles the contract.
 	/// This function should only be internally called by compileContract and generateEVMFromIR.
+	/// Warnings about the code size are reported to @a _errorReporter.
 	void assembleYul(
 		ContractDefinition const& _contract,
 		std::shared_ptr<evmasm::Assembly> _assembly,
-		std::shared_ptr<evmasm::Assembly> _runtimeAssembly
+		std::shared_ptr<evmasm::Assembly> _runtimeAssembly,
+		langutil::ErrorReporter& _errorReporter
 	);
 
 	/// Compile a single contract.
@@ -439,11 +514,62 @@ private:
 
 	/// Generate Yul IR for a single contract.
 	/// The IR is stored but otherwise unused.
-	void generateIR(ContractDefinition const& _contract);
+	/// Unless @a _deferYulOptimization is set, the IR is also parsed and optimized using parseIR
+	/// and optimizeIR.
+	void generateIR(ContractDefinition const& _contract, bool _deferYulOptimization = false);
+
+	/// Records how often the parsed IR of each contract will be used when optimizing the IR of
+	/// @a _contracts, so that it can be freed after its last use. Has to be called before parseIR.
+	void countIRObjectUses(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Parses the Yul IR of a single contract without the objects of the contracts it creates,
+	/// unless it is not used by any contract. Depends on output generated by generateIR.
+	/// Only touches the stored output of the given contract, so it can run concurrently for
+	/// different contracts.
+	void parseIR(ContractDefinition const& _contract);
+
+	/// Analyzes and optimizes the Yul IR of a single contract.
+	/// Depends on output generated by parseIR for the contract and all contracts it creates.
+	/// Only touches the Yul representation and the stored output of the given contract, so it can
+	/// run concurrently for different contracts.
+	/// The optimiser transforms the functions of the contract on up to @a _jobs threads.
+	void optimizeIR(ContractDefinition const& _contract, size_t _jobs = 1);
+
+	/// @returns the Yul object of @a _contract built from the objects stored by parseIR, i.e.
+	/// with the objects of the created contracts instead of the placeholders.
+	/// @a _builtObjects holds the objects already built for this, which are copied if a contract
+	/// is created more than once.
+	std::shared_ptr<yul::Object> buildIRObject(
+		ContractDefinition const& _contract,
+		std::map<ContractDefinition const*, std::shared_ptr<yul::Object const>>& _builtObjects
+	);
+
+	/// @returns the object stored by parseIR for @a _contract and records its use.
+	/// The stored object is only copied if it is used again later.
+	std::shared_ptr<yul::Object> useIRObject(Contract& _compiledContract);
+
+	/// Changes the native source locations in @a _object, the optimized object of @a _contract,
+	/// to refer to yulIR, like when the object is parsed from it, instead of to the IR with
+	/// placeholders that parseIR parsed.
+	void mapNativeLocationsToIR(yul::Object& _object, ContractDefinition const& _contract) const;
+
+	/// Parses and analyzes Yul IR produced by generateIR.
+	std::shared_ptr<yul::YulStack> loadGeneratedIR(std::string const& _ir) const;
 
 	/// Generate EVM representation for a single contract.
-	/// Depends on output generated by generateIR.
-	void generateEVMFromIR(ContractDefinition const& _contract);
+	/// Depends on output generated by optimizeIR. Like optimizeIR, it can run concurrently for
+	/// different contracts as long as each uses its own @a _errorReporter.
+	void generateEVMFromIR(ContractDefinition const& _contract, langutil::ErrorReporter& _errorReporter);
+
+	/// Optimizes the IR and generates EVM code for @a _contracts on m_parallelJobs threads.
+	/// Generating the IR and merging the reported errors happens on the calling thread, in the
+	/// same order as the sequential pipeline would produce them.
+	/// @returns false if a code generation error was reported.
+	bool generateCodeInParallel(std::vector<ContractDefinition const*> const& _contracts);
+
+	/// Rethrows @a _exception and reports it as an error if it is a code generation error.
+	/// Any other exception is propagated.
+	void reportCodegenError(std::exception_ptr _exception);
 
 	/// Links all the known library addresses in the available objects. Any unknown
 	/// library will still be kept as an unlinked placeholder in the objects.
@@ -503,8 +629,18 @@ private:
 	std::map<std::string, std::set<std::string>> m_requestedContractNames;
 	bool m_generateEvmBytecode = true;
 	bool m_generateIR = false;
+	bool m_profileOptimiser = false;
+	size_t m_parallelJobs = 1;
+	/// Optimized code of the Yul objects seen during the current compilation. The IR of a contract
+	/// includes the objects of all contracts it creates, which thus only have to be optimized once.
+	std::shared_ptr<yul::OptimizedCodeCache> m_optimizedCodeCache;
+	/// Guards the parsed IR objects of the contracts and their use counts.
+	std::mutex m_irObjectsMutex;
 	std::map<std::string, util::h192> m_libraries;
 	ImportRemapper m_importRemapper;
+	/// Owns the types of this compilation. Activated on the calling thread by the functions
+	/// that access the type system.
+	std::unique_ptr<TypeProvider> m_typeProvider;
 	std::map<std::string const, Source> m_sources;
 	std::vector<std::string> m_unhandledSMTLib2Queries;
 	std::map<util::h256, std::string> m_smtlib2Responses;
@@ -514,6 +650,8 @@ private:
 
 	langutil::ErrorList m_errorList;
 	langutil::ErrorReporter m_errorReporter;
+	/// Number of errors reported up to the end of the analysis.
+	size_t m_analysisErrorCount = 0;
 	bool m_metadataLiteralSources = false;
 	MetadataHash m_metadataHash = MetadataHash::IPFS;
 	langutil::DebugInfoSelection m_debugInfoSelection = langutil::DebugInfoSelection::Default();
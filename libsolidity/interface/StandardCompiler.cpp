@@ -23,10 +23,13 @@
 
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/interface/ImportRemapper.h>
+#include <libsolidity/interface/Version.h>
 
 #include <libsolidity/ast/ASTJsonExporter.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libyul/YulStack.h>
 #include <libyul/Exceptions.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 #include <libyul/optimiser/Suite.h>
 
 #include <libevmasm/Disassemble.h>
@@ -43,6 +46,7 @@
 
 #include <algorithm>
 #include <optional>
+#include <sstream>
 
 using namespace std;
 using namespace solidity;
@@ -164,6 +168,19 @@ map<string, set<string>> requestedContractNames(Json::Value const& _outputSelect
 	return contracts;
 }
 
+/// @returns the names of the sources parsed and analyzed by the compiler stack for the output
+/// selection @a _outputSelection, or nullopt if all sources are.
+optional<set<string>> requestedSourceNames(Json::Value const& _outputSelection)
+{
+	map<string, set<string>> const contractNames = requestedContractNames(_outputSelection);
+	if (contractNames.empty() || contractNames.count(""))
+		return nullopt;
+	set<string> sourceNames;
+	for (auto const& [sourceName, contracts]: contractNames)
+		sourceNames.insert(sourceName);
+	return sourceNames;
+}
+
 /// Returns true iff @a _hash (hex with 0x prefix) is the Keccak256 hash of the binary data in @a _content.
 bool hashMatchesContent(string const& _hash, string const& _content)
 {
@@ -406,7 +423,7 @@ std::optional<Json::Value> checkKeys(Json::Value const& _input, set<string> cons
 
 std::optional<Json::Value> checkRootKeys(Json::Value const& _input)
 {
-	static set<string> keys{"auxiliaryInput", "language", "settings", "sources"};
+	static set<string> keys{"auxiliaryInput", "language", "settings", "settingsVariants", "sources"};
 	return checkKeys(_input, keys, "root");
 }
 
@@ -424,7 +441,7 @@ std::optional<Json::Value> checkAuxiliaryInputKeys(Json::Value const& _input)
 
 std::optional<Json::Value> checkSettingsKeys(Json::Value const& _input)
 {
-	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "libraries", "metadata", "modelChecker", "optimizer", "outputSelection", "remappings", "stopAfter", "viaIR"};
+	static set<string> keys{"parserErrorRecovery", "debug", "evmVersion", "jobs", "libraries", "metadata", "modelChecker", "optimizer", "optimizerProfile", "outputSelection", "remappings", "stopAfter", "viaIR"};
 	return checkKeys(_input, keys, "settings");
 }
 
@@ -617,6 +634,161 @@ std::variant<OptimiserSettings, Json::Value> parseOptimizerSettings(Json::Value
 	return { std::move(settings) };
 }
 
+bool containsErrors(Json::Value const& _output)
+{
+	for (Json::Value const& error: _output["errors"])
+		if (error["severity"] == "error")
+			return true;
+	for (Json::Value const& variantOutput: _output["variants"])
+		if (containsErrors(variantOutput))
+			return true;
+	return false;
+}
+
+/// Appends @a _data to @a _key in a way that keeps the boundaries between the parts unambiguous.
+void appendToCacheKey(string& _key, string const& _data)
+{
+	_key += to_string(_data.size()) + ":" + _data;
+}
+
+/// @returns the output reporting the exception currently being handled.
+Json::Value formatCurrentException()
+{
+	try
+	{
+		throw;
+	}
+	catch (Json::LogicError const& _exception)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, string("JSON logic exception: ") + _exception.what());
+	}
+	catch (Json::RuntimeError const& _exception)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, string("JSON runtime exception: ") + _exception.what());
+	}
+	catch (util::Exception const& _exception)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+	}
+	catch (...)
+	{
+		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+	}
+}
+
+}
+
+class StandardCompiler::JsonOutputSink: public StandardCompiler::OutputSink
+{
+public:
+	void member(string const& _key, Json::Value _value) override
+	{
+		m_output[_key] = std::move(_value);
+	}
+
+	void contract(string const& _sourceName, string const& _contractName, Json::Value _output) override
+	{
+		m_output["contracts"][_sourceName][_contractName] = std::move(_output);
+	}
+
+	Json::Value result() { return std::move(m_output); }
+
+private:
+	Json::Value m_output = Json::objectValue;
+};
+
+class StandardCompiler::StreamingOutputSink: public StandardCompiler::OutputSink
+{
+public:
+	StreamingOutputSink(ostream& _output, util::JsonFormat const& _format): m_writer(_output, _format) {}
+
+	void member(string const& _key, Json::Value _value) override
+	{
+		closeContracts();
+		// The errors are only written together with the next member, so that errors of a
+		// failure while producing that member can still be added to them.
+		if (_key == "errors")
+		{
+			m_errors = std::move(_value);
+			return;
+		}
+		if (_key > "errors")
+			writeErrors();
+		m_writer.member(_key, _value);
+	}
+
+	void contract(string const& _sourceName, string const& _contractName, Json::Value _output) override
+	{
+		if (m_currentSource != _sourceName)
+		{
+			if (m_currentSource)
+				m_writer.endObject();
+			else
+				m_writer.beginObject("contracts");
+			m_writer.beginObject(_sourceName);
+			m_currentSource = _sourceName;
+		}
+		m_writer.member(_contractName, _output);
+	}
+
+	/// Completes the output after a failure, which is reported by the errors in @a _failure.
+	/// The parts of the output written before are kept.
+	void fail(Json::Value const& _failure)
+	{
+		closeContracts();
+		if (!m_errorsWritten)
+		{
+			if (!m_errors.isArray())
+				m_errors = Json::arrayValue;
+			for (Json::Value const& error: _failure["errors"])
+				m_errors.append(error);
+		}
+		finish();
+	}
+
+	void finish()
+	{
+		closeContracts();
+		writeErrors();
+		m_writer.finish();
+	}
+
+private:
+	void closeContracts()
+	{
+		if (!m_currentSource)
+			return;
+		m_writer.endObject();
+		m_writer.endObject();
+		m_currentSource.reset();
+	}
+
+	void writeErrors()
+	{
+		if (m_errorsWritten)
+			return;
+		m_errorsWritten = true;
+		if (!m_errors.isNull())
+			m_writer.member("errors", std::move(m_errors));
+	}
+
+	util::JsonObjectStreamWriter m_writer;
+	optional<string> m_currentSource;
+	Json::Value m_errors;
+	bool m_errorsWritten = false;
+};
+
+void StandardCompiler::sendOutput(Json::Value _output, OutputSink& _sink)
+{
+	for (string const& key: _output.getMemberNames())
+		if (key == "contracts")
+		{
+			for (string const& sourceName: _output[key].getMemberNames())
+				for (string const& contractName: _output[key][sourceName].getMemberNames())
+					_sink.contract(sourceName, contractName, std::move(_output[key][sourceName][contractName]));
+		}
+		else
+			_sink.member(key, std::move(_output[key]));
 }
 
 
@@ -788,6 +960,20 @@ std::variant<StandardCompiler::InputsAndSettings, Json::Value> StandardCompiler:
 		ret.viaIR = settings["viaIR"].asBool();
 	}
 
+	if (settings.isMember("jobs"))
+	{
+		if (!settings["jobs"].isUInt() || settings["jobs"].asUInt() == 0)
+			return formatFatalError(Error::Type::JSONError, "\"settings.jobs\" must be a positive integer.");
+		ret.parallelJobs = settings["jobs"].asUInt();
+	}
+
+	if (settings.isMember("optimizerProfile"))
+	{
+		if (!settings["optimizerProfile"].isBool())
+			return formatFatalError(Error::Type::JSONError, "\"settings.optimizerProfile\" must be a Boolean.");
+		ret.optimizerProfile = settings["optimizerProfile"].asBool();
+	}
+
 	if (settings.isMember("evmVersion"))
 	{
 		if (!settings["evmVersion"].isString())
@@ -1156,32 +1342,102 @@ map<string, Json::Value> StandardCompiler::parseAstFromInput(StringMap const& _s
 	return sourceJsons;
 }
 
-Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings)
+void StandardCompiler::compileSolidity(StandardCompiler::InputsAndSettings _inputsAndSettings, OutputSink& _output)
 {
-	CompilerStack compilerStack(m_readFile);
+	if (!m_reuseAnalysis || _inputsAndSettings.language != "Solidity")
+	{
+		CompilerStack compilerStack(m_readFile);
+		compileSolidity(compilerStack, std::move(_inputsAndSettings), _output);
+		return;
+	}
+
+	if (canReuseLastAnalysis(_inputsAndSettings))
+		++m_reusedAnalyses;
+	else
+	{
+		auto analysis = make_unique<Analysis>();
+		analysis->inputsAndSettings = _inputsAndSettings;
+		// The callback is looked up on each call, since compileWithCache replaces it temporarily
+		// while the compiler stack may be kept for later inputs.
+		ReadCallback::Callback readFile;
+		if (m_readFile)
+			readFile = [this, &reads = analysis->reads](string const& _kind, string const& _path) {
+				ReadCallback::Result result = m_readFile(_kind, _path);
+				reads.emplace_back(make_pair(_kind, _path), result);
+				return result;
+			};
+		analysis->compilerStack = make_unique<CompilerStack>(std::move(readFile));
+		m_lastAnalysis = std::move(analysis);
+	}
+
+	compileSolidity(*m_lastAnalysis->compilerStack, std::move(_inputsAndSettings), _output);
+	// Like in a batch, only a successful analysis is reused.
+	if (
+		m_lastAnalysis->compilerStack->state() < CompilerStack::State::AnalysisPerformed ||
+		m_lastAnalysis->compilerStack->hasError()
+	)
+		m_lastAnalysis.reset();
+}
 
+bool StandardCompiler::canReuseLastAnalysis(InputsAndSettings const& _inputsAndSettings)
+{
+	if (!m_lastAnalysis || !sharesAnalysis(m_lastAnalysis->inputsAndSettings, _inputsAndSettings))
+		return false;
+
+	// The files read through the callback may have changed in the meantime. Other kinds of
+	// requests, like SMT queries, are not repeated.
+	for (auto const& [read, result]: m_lastAnalysis->reads)
+	{
+		if (read.first != ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+			return false;
+		ReadCallback::Result currentResult = m_readFile(read.first, read.second);
+		if (
+			currentResult.success != result.success ||
+			currentResult.responseOrErrorMessage != result.responseOrErrorMessage
+		)
+			return false;
+	}
+	return true;
+}
+
+void StandardCompiler::compileSolidity(
+	CompilerStack& _compilerStack,
+	StandardCompiler::InputsAndSettings _inputsAndSettings,
+	OutputSink& _output
+)
+{
+	// The outputs are produced from the types of the analyzed sources.
+	TypeProvider::Scope typeProviderScope{_compilerStack.typeProvider()};
 	StringMap sourceList = std::move(_inputsAndSettings.sources);
-	if (_inputsAndSettings.language == "Solidity")
-		compilerStack.setSources(sourceList);
-	for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
-		compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
-	compilerStack.setViaIR(_inputsAndSettings.viaIR);
-	compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
-	compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
-	compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
-	compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
-	compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
-	if (_inputsAndSettings.debugInfoSelection.has_value())
-		compilerStack.selectDebugInfo(_inputsAndSettings.debugInfoSelection.value());
-	compilerStack.setLibraries(_inputsAndSettings.libraries);
-	compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
-	compilerStack.setMetadataFormat(_inputsAndSettings.metadataFormat);
-	compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
-	compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
-	compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
-
-	compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
-	compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	if (_compilerStack.state() == CompilerStack::State::Empty)
+	{
+		if (_inputsAndSettings.language == "Solidity")
+			_compilerStack.setSources(sourceList);
+		for (auto const& smtLib2Response: _inputsAndSettings.smtLib2Responses)
+			_compilerStack.addSMTLib2Response(smtLib2Response.first, smtLib2Response.second);
+		_compilerStack.setEVMVersion(_inputsAndSettings.evmVersion);
+		_compilerStack.setParserErrorRecovery(_inputsAndSettings.parserErrorRecovery);
+		_compilerStack.setRemappings(std::move(_inputsAndSettings.remappings));
+		_compilerStack.setModelCheckerSettings(_inputsAndSettings.modelCheckerSettings);
+	}
+	else
+		// The sources were analyzed with the same settings by a previous variant of a batch.
+		_compilerStack.resetCodeGeneration();
+
+	_compilerStack.setViaIR(_inputsAndSettings.viaIR);
+	_compilerStack.setParallelJobs(_inputsAndSettings.parallelJobs);
+	_compilerStack.setRevertStringBehaviour(_inputsAndSettings.revertStrings);
+	_compilerStack.setLibraries(_inputsAndSettings.libraries);
+	_compilerStack.useMetadataLiteralSources(_inputsAndSettings.metadataLiteralSources);
+	_compilerStack.setMetadataFormat(_inputsAndSettings.metadataFormat);
+	_compilerStack.setMetadataHash(_inputsAndSettings.metadataHash);
+	_compilerStack.setOptimiserSettings(std::move(_inputsAndSettings.optimiserSettings));
+	_compilerStack.selectDebugInfo(_inputsAndSettings.debugInfoSelection.value_or(DebugInfoSelection::Default()));
+	_compilerStack.setRequestedContractNames(requestedContractNames(_inputsAndSettings.outputSelection));
+
+	_compilerStack.enableEvmBytecodeGeneration(isEvmBytecodeRequested(_inputsAndSettings.outputSelection));
+	_compilerStack.enableIRGeneration(isIRRequested(_inputsAndSettings.outputSelection));
+	_compilerStack.enableOptimiserProfiling(_inputsAndSettings.optimizerProfile);
 
 	Json::Value errors = std::move(_inputsAndSettings.errors);
 
@@ -1193,11 +1449,11 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		{
 			try
 			{
-				compilerStack.importASTs(parseAstFromInput(sourceList));
-				if (!compilerStack.analyze())
+				_compilerStack.importASTs(parseAstFromInput(sourceList));
+				if (!_compilerStack.analyze())
 					errors.append(formatError(Error::Type::FatalError, "general", "Analysis of the AST failed."));
 				if (binariesRequested)
-					compilerStack.compile();
+					_compilerStack.compile();
 			}
 			catch (util::Exception const& _exc)
 			{
@@ -1207,13 +1463,13 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		else
 		{
 			if (binariesRequested)
-				compilerStack.compile();
-			else
-				compilerStack.parseAndAnalyze(_inputsAndSettings.stopAfter);
+				_compilerStack.compile();
+			else if (_compilerStack.state() < CompilerStack::State::AnalysisPerformed)
+				_compilerStack.parseAndAnalyze(_inputsAndSettings.stopAfter);
 
-			for (auto const& error: compilerStack.errors())
+			for (auto const& error: _compilerStack.errors())
 				errors.append(formatErrorWithException(
-					compilerStack,
+					_compilerStack,
 					*error,
 					error->type(),
 					"general",
@@ -1226,7 +1482,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (Error const& _error)
 	{
 		errors.append(formatErrorWithException(
-			compilerStack,
+			_compilerStack,
 			_error,
 			_error.type(),
 			"general",
@@ -1245,7 +1501,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (CompilerError const& _exception)
 	{
 		errors.append(formatErrorWithException(
-			compilerStack,
+			_compilerStack,
 			_exception,
 			Error::Type::CompilerError,
 			"general",
@@ -1255,7 +1511,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (InternalCompilerError const& _exception)
 	{
 		errors.append(formatErrorWithException(
-			compilerStack,
+			_compilerStack,
 			_exception,
 			Error::Type::InternalCompilerError,
 			"general",
@@ -1265,7 +1521,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (UnimplementedFeatureError const& _exception)
 	{
 		errors.append(formatErrorWithException(
-			compilerStack,
+			_compilerStack,
 			_exception,
 			Error::Type::UnimplementedFeatureError,
 			"general",
@@ -1275,7 +1531,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (yul::YulException const& _exception)
 	{
 		errors.append(formatErrorWithException(
-			compilerStack,
+			_compilerStack,
 			_exception,
 			Error::Type::YulException,
 			"general",
@@ -1285,7 +1541,7 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 	catch (smtutil::SMTLogicError const& _exception)
 	{
 		errors.append(formatErrorWithException(
-			compilerStack,
+			_compilerStack,
 			_exception,
 			Error::Type::SMTLogicException,
 			"general",
@@ -1317,11 +1573,11 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		));
 	}
 
-	bool parsingSuccess = compilerStack.state() >= CompilerStack::State::Parsed;
-	bool analysisPerformed = compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
-	bool compilationSuccess = compilerStack.state() == CompilerStack::State::CompilationSuccessful;
+	bool parsingSuccess = _compilerStack.state() >= CompilerStack::State::Parsed;
+	bool analysisPerformed = _compilerStack.state() >= CompilerStack::State::AnalysisPerformed;
+	bool compilationSuccess = _compilerStack.state() == CompilerStack::State::CompilationSuccessful;
 
-	if (compilerStack.hasError() && !_inputsAndSettings.parserErrorRecovery)
+	if (_compilerStack.hasError() && !_inputsAndSettings.parserErrorRecovery)
 		analysisPerformed = false;
 
 	// If analysis fails, the artifacts inside CompilerStack are potentially incomplete and must not be returned.
@@ -1334,72 +1590,72 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		(compilationFailed || !analysisPerformed) &&
 		(errors.empty() && _inputsAndSettings.stopAfter >= CompilerStack::State::AnalysisPerformed)
 	)
-		return formatFatalError(Error::Type::InternalCompilerError, "No error reported, but compilation failed.");
-
-	Json::Value output = Json::objectValue;
-
-	if (errors.size() > 0)
-		output["errors"] = std::move(errors);
+		return sendOutput(
+			formatFatalError(Error::Type::InternalCompilerError, "No error reported, but compilation failed."),
+			_output
+		);
 
-	if (!compilerStack.unhandledSMTLib2Queries().empty())
-		for (string const& query: compilerStack.unhandledSMTLib2Queries())
-			output["auxiliaryInputRequested"]["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+	// The members of the output are produced in the order in which they are serialized.
+	if (!_compilerStack.unhandledSMTLib2Queries().empty())
+	{
+		Json::Value auxiliaryInputRequested = Json::objectValue;
+		for (string const& query: _compilerStack.unhandledSMTLib2Queries())
+			auxiliaryInputRequested["smtlib2queries"]["0x" + util::keccak256(query).hex()] = query;
+		_output.member("auxiliaryInputRequested", std::move(auxiliaryInputRequested));
+	}
 
 	bool const wildcardMatchesExperimental = false;
 
-	output["sources"] = Json::objectValue;
-	unsigned sourceIndex = 0;
-	if (parsingSuccess && !analysisFailed && (!compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
-		for (string const& sourceName: compilerStack.sourceNames())
-		{
-			Json::Value sourceResult = Json::objectValue;
-			sourceResult["id"] = sourceIndex++;
-			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
-				sourceResult["ast"] = ASTJsonExporter(compilerStack.state(), compilerStack.sourceIndices()).toJson(compilerStack.ast(sourceName));
-			output["sources"][sourceName] = sourceResult;
-		}
-
-	Json::Value contractsOutput = Json::objectValue;
-	for (string const& contractName: analysisPerformed ? compilerStack.contractNames() : vector<string>())
+	vector<pair<string, string>> contracts;
+	for (string const& contractName: analysisPerformed ? _compilerStack.contractNames() : vector<string>())
 	{
 		size_t colon = contractName.rfind(':');
 		solAssert(colon != string::npos, "");
-		string file = contractName.substr(0, colon);
-		string name = contractName.substr(colon + 1);
+		contracts.emplace_back(contractName.substr(0, colon), contractName.substr(colon + 1));
+	}
+	sort(contracts.begin(), contracts.end());
+	for (auto const& sourceAndContractName: contracts)
+	{
+		string const& file = sourceAndContractName.first;
+		string const& name = sourceAndContractName.second;
+		string const contractName = file + ":" + name;
 
 		// ABI, storage layout, documentation and metadata
 		Json::Value contractData(Json::objectValue);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "abi", wildcardMatchesExperimental))
-			contractData["abi"] = compilerStack.contractABI(contractName);
+			contractData["abi"] = _compilerStack.contractABI(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "storageLayout", false))
-			contractData["storageLayout"] = compilerStack.storageLayout(contractName);
+			contractData["storageLayout"] = _compilerStack.storageLayout(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "metadata", wildcardMatchesExperimental))
-			contractData["metadata"] = compilerStack.metadata(contractName);
+			contractData["metadata"] = _compilerStack.metadata(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "userdoc", wildcardMatchesExperimental))
-			contractData["userdoc"] = compilerStack.natspecUser(contractName);
+			contractData["userdoc"] = _compilerStack.natspecUser(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "devdoc", wildcardMatchesExperimental))
-			contractData["devdoc"] = compilerStack.natspecDev(contractName);
+			contractData["devdoc"] = _compilerStack.natspecDev(contractName);
 
 		// IR
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "ir", wildcardMatchesExperimental))
-			contractData["ir"] = compilerStack.yulIR(contractName);
+			contractData["ir"] = _compilerStack.yulIR(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irAst", wildcardMatchesExperimental))
-			contractData["irAst"] = compilerStack.yulIRAst(contractName);
+			contractData["irAst"] = _compilerStack.yulIRAst(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimized", wildcardMatchesExperimental))
-			contractData["irOptimized"] = compilerStack.yulIROptimized(contractName);
+			contractData["irOptimized"] = _compilerStack.yulIROptimized(contractName);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "irOptimizedAst", wildcardMatchesExperimental))
-			contractData["irOptimizedAst"] = compilerStack.yulIROptimizedAst(contractName);
+			contractData["irOptimizedAst"] = _compilerStack.yulIROptimizedAst(contractName);
+		if (compilationSuccess && _inputsAndSettings.optimizerProfile)
+			if (Json::Value profile = _compilerStack.optimiserProfile(contractName); !profile.isNull())
+				contractData["optimizerProfile"] = std::move(profile);
 
 		// EVM
 		Json::Value evmData(Json::objectValue);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.assembly", wildcardMatchesExperimental))
-			evmData["assembly"] = compilerStack.assemblyString(contractName, sourceList);
+			evmData["assembly"] = _compilerStack.assemblyString(contractName, sourceList);
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.legacyAssembly", wildcardMatchesExperimental))
-			evmData["legacyAssembly"] = compilerStack.assemblyJSON(contractName);
+			evmData["legacyAssembly"] = _compilerStack.assemblyJSON(contractName);
 		if (isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.methodIdentifiers", wildcardMatchesExperimental))
-			evmData["methodIdentifiers"] = compilerStack.interfaceSymbols(contractName)["methods"];
+			evmData["methodIdentifiers"] = _compilerStack.interfaceSymbols(contractName)["methods"];
 		if (compilationSuccess && isArtifactRequested(_inputsAndSettings.outputSelection, file, name, "evm.gasEstimates", wildcardMatchesExperimental))
-			evmData["gasEstimates"] = compilerStack.gasEstimates(contractName);
+			evmData["gasEstimates"] = _compilerStack.gasEstimates(contractName);
 
 		if (compilationSuccess && isArtifactRequested(
 			_inputsAndSettings.outputSelection,
@@ -1410,9 +1666,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		))
 			evmData["bytecode"] = collectEVMObject(
 				_inputsAndSettings.evmVersion,
-				compilerStack.object(contractName),
-				compilerStack.sourceMapping(contractName),
-				compilerStack.generatedSources(contractName),
+				_compilerStack.object(contractName),
+				_compilerStack.sourceMapping(contractName),
+				_compilerStack.generatedSources(contractName),
 				false,
 				[&](string const& _element) { return isArtifactRequested(
 					_inputsAndSettings.outputSelection,
@@ -1432,9 +1688,9 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 		))
 			evmData["deployedBytecode"] = collectEVMObject(
 				_inputsAndSettings.evmVersion,
-				compilerStack.runtimeObject(contractName),
-				compilerStack.runtimeSourceMapping(contractName),
-				compilerStack.generatedSources(contractName, true),
+				_compilerStack.runtimeObject(contractName),
+				_compilerStack.runtimeSourceMapping(contractName),
+				_compilerStack.generatedSources(contractName, true),
 				true,
 				[&](string const& _element) { return isArtifactRequested(
 					_inputsAndSettings.outputSelection,
@@ -1446,19 +1702,27 @@ Json::Value StandardCompiler::compileSolidity(StandardCompiler::InputsAndSetting
 			);
 
 		if (!evmData.empty())
-			contractData["evm"] = evmData;
+			contractData["evm"] = std::move(evmData);
 
 		if (!contractData.empty())
-		{
-			if (!contractsOutput.isMember(file))
-				contractsOutput[file] = Json::objectValue;
-			contractsOutput[file][name] = contractData;
-		}
+			_output.contract(file, name, std::move(contractData));
 	}
-	if (!contractsOutput.empty())
-		output["contracts"] = contractsOutput;
 
-	return output;
+	if (errors.size() > 0)
+		_output.member("errors", std::move(errors));
+
+	Json::Value sources = Json::objectValue;
+	unsigned sourceIndex = 0;
+	if (parsingSuccess && !analysisFailed && (!_compilerStack.hasError() || _inputsAndSettings.parserErrorRecovery))
+		for (string const& sourceName: _compilerStack.sourceNames())
+		{
+			Json::Value sourceResult = Json::objectValue;
+			sourceResult["id"] = sourceIndex++;
+			if (isArtifactRequested(_inputsAndSettings.outputSelection, sourceName, "", "ast", wildcardMatchesExperimental))
+				sourceResult["ast"] = ASTJsonExporter(_compilerStack.state(), _compilerStack.sourceIndices()).toJson(_compilerStack.ast(sourceName));
+			sources[sourceName] = std::move(sourceResult);
+		}
+	_output.member("sources", std::move(sources));
 }
 
 
@@ -1557,7 +1821,10 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 		sourceResult["ast"] = stack.astJson();
 		output["sources"][sourceName] = sourceResult;
 	}
-	stack.optimize();
+	OptimiserProfile optimizerProfile;
+	stack.optimize(_inputsAndSettings.optimizerProfile ? &optimizerProfile : nullptr);
+	if (_inputsAndSettings.optimizerProfile)
+		output["contracts"][sourceName][contractName]["optimizerProfile"] = optimizerProfile.toJson();
 
 	MachineAssemblyObject object;
 	MachineAssemblyObject deployedObject;
@@ -1607,69 +1874,316 @@ Json::Value StandardCompiler::compileYul(InputsAndSettings _inputsAndSettings)
 
 Json::Value StandardCompiler::compile(Json::Value const& _input) noexcept
 {
-	YulStringRepository::reset();
-
+	// The YulString repository is not reset here, since other compilations may run concurrently
+	// and still use its strings. Long-running users reset it between compilations instead.
 	try
 	{
-		auto parsed = parseInput(_input);
-		if (std::holds_alternative<Json::Value>(parsed))
-			return std::get<Json::Value>(std::move(parsed));
-		InputsAndSettings settings = std::get<InputsAndSettings>(std::move(parsed));
-		if (settings.language == "Solidity")
-			return compileSolidity(std::move(settings));
-		else if (settings.language == "Yul")
-			return compileYul(std::move(settings));
-		else if (settings.language == "SolidityAST")
-			return compileSolidity(std::move(settings));
-		else
-			return formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\" or \"SolidityAST\" is supported as a language.");
+		if (m_cache)
+			return compileWithCache(_input);
+		return compileInput(_input);
 	}
-	catch (Json::LogicError const& _exception)
+	catch (...)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, string("JSON logic exception: ") + _exception.what());
+		return formatCurrentException();
 	}
-	catch (Json::RuntimeError const& _exception)
+}
+
+Json::Value StandardCompiler::compileInput(Json::Value const& _input)
+{
+	JsonOutputSink output;
+	compileInput(_input, output);
+	return output.result();
+}
+
+void StandardCompiler::compileInput(Json::Value const& _input, OutputSink& _output)
+{
+	if (_input.isObject() && _input.isMember("settingsVariants"))
+		return compileBatch(_input, _output);
+
+	auto parsed = parseInput(_input);
+	if (std::holds_alternative<Json::Value>(parsed))
+		return sendOutput(std::get<Json::Value>(std::move(parsed)), _output);
+	compileParsedInput(std::get<InputsAndSettings>(std::move(parsed)), _output);
+}
+
+void StandardCompiler::compileParsedInput(InputsAndSettings _inputsAndSettings, OutputSink& _output)
+{
+	if (_inputsAndSettings.language == "Solidity")
+		compileSolidity(std::move(_inputsAndSettings), _output);
+	else if (_inputsAndSettings.language == "Yul")
+		sendOutput(compileYul(std::move(_inputsAndSettings)), _output);
+	else if (_inputsAndSettings.language == "SolidityAST")
+		compileSolidity(std::move(_inputsAndSettings), _output);
+	else
+		sendOutput(
+			formatFatalError(Error::Type::JSONError, "Only \"Solidity\", \"Yul\" or \"SolidityAST\" is supported as a language."),
+			_output
+		);
+}
+
+bool StandardCompiler::sharesAnalysis(InputsAndSettings const& _a, InputsAndSettings const& _b)
+{
+	// These are the settings that have to be set on the compiler stack before parsing.
+	// The output selection determines which sources are parsed and analyzed.
+	return
+		_a.language == "Solidity" &&
+		_b.language == "Solidity" &&
+		_a.parserErrorRecovery == _b.parserErrorRecovery &&
+		_a.stopAfter == _b.stopAfter &&
+		_a.sources == _b.sources &&
+		_a.smtLib2Responses == _b.smtLib2Responses &&
+		_a.evmVersion == _b.evmVersion &&
+		_a.remappings == _b.remappings &&
+		requestedSourceNames(_a.outputSelection) == requestedSourceNames(_b.outputSelection) &&
+		_a.optimiserSettings.runYulOptimiser == _b.optimiserSettings.runYulOptimiser &&
+		_a.modelCheckerSettings == _b.modelCheckerSettings;
+}
+
+void StandardCompiler::compileBatch(Json::Value const& _input, OutputSink& _output)
+{
+	Json::Value const& variants = _input["settingsVariants"];
+	if (!variants.isArray() || variants.empty())
+		return sendOutput(
+			formatFatalError(Error::Type::JSONError, "\"settingsVariants\" must be a non-empty array."),
+			_output
+		);
+
+	Json::Value baseInput = _input;
+	baseInput.removeMember("settingsVariants");
+	bool const canMergeSettings = !baseInput.isMember("settings") || baseInput["settings"].isObject();
+
+	// All variants are parsed first, so that each one can be compared to the previous ones.
+	vector<variant<InputsAndSettings, Json::Value>> parsedVariants;
+	for (Json::Value const& variantSettings: variants)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, string("JSON runtime exception: ") + _exception.what());
+		if (!variantSettings.isObject())
+		{
+			parsedVariants.emplace_back(formatFatalError(Error::Type::JSONError, "Each settings variant must be an object."));
+			continue;
+		}
+		// The members of the variant replace the members of the same name in "settings".
+		Json::Value variantInput = baseInput;
+		if (canMergeSettings)
+			for (string const& key: variantSettings.getMemberNames())
+				variantInput["settings"][key] = variantSettings[key];
+		parsedVariants.emplace_back(parseInput(variantInput));
+	}
+
+	// Variants that only differ in settings used by the code generator share the analysis
+	// performed by the first of them.
+	vector<size_t> analysisOwner(parsedVariants.size());
+	for (size_t index = 0; index < parsedVariants.size(); ++index)
+	{
+		analysisOwner[index] = index;
+		if (auto const* settings = get_if<InputsAndSettings>(&parsedVariants[index]))
+			for (size_t owner = 0; owner < index; ++owner)
+				if (auto const* ownerSettings = get_if<InputsAndSettings>(&parsedVariants[owner]))
+					if (analysisOwner[owner] == owner && sharesAnalysis(*ownerSettings, *settings))
+					{
+						analysisOwner[index] = owner;
+						break;
+					}
 	}
-	catch (util::Exception const& _exception)
+
+	Json::Value outputs(Json::arrayValue);
+	map<size_t, unique_ptr<CompilerStack>> compilerStacks;
+	for (size_t index = 0; index < parsedVariants.size(); ++index)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " + boost::diagnostic_information(_exception));
+		JsonOutputSink variantOutput;
+		if (holds_alternative<Json::Value>(parsedVariants[index]))
+			sendOutput(get<Json::Value>(std::move(parsedVariants[index])), variantOutput);
+		else if (get<InputsAndSettings>(parsedVariants[index]).language != "Solidity")
+			compileParsedInput(get<InputsAndSettings>(std::move(parsedVariants[index])), variantOutput);
+		else
+		{
+			unique_ptr<CompilerStack>& compilerStack = compilerStacks[analysisOwner[index]];
+			// Only a successful analysis is reused. Otherwise, each variant reports its own failure.
+			if (
+				!compilerStack ||
+				compilerStack->state() < CompilerStack::State::AnalysisPerformed ||
+				compilerStack->hasError()
+			)
+				compilerStack = make_unique<CompilerStack>(m_readFile);
+			compileSolidity(*compilerStack, get<InputsAndSettings>(std::move(parsedVariants[index])), variantOutput);
+		}
+		outputs.append(variantOutput.result());
+	}
+	_output.member("variants", std::move(outputs));
+}
+
+Json::Value StandardCompiler::compileWithCache(Json::Value const& _input)
+{
+	solAssert(m_cache);
+
+	// A stored profile would not describe the cost of the current compilation.
+	if (isOptimizerProfileRequested(_input))
+		return compileInput(_input);
+
+	Json::Value input = _input;
+	// The number of parallel jobs does not influence the output.
+	if (input.isObject() && input.isMember("settings") && input["settings"].isObject())
+		input["settings"].removeMember("jobs");
+	if (input.isObject() && input.isMember("settingsVariants") && input["settingsVariants"].isArray())
+		for (Json::Value& variantSettings: input["settingsVariants"])
+			if (variantSettings.isObject())
+				variantSettings.removeMember("jobs");
+	string inputKey;
+	appendToCacheKey(inputKey, VersionString);
+	appendToCacheKey(inputKey, util::jsonCompactPrint(input));
+	util::h256 const manifestKey = util::keccak256("manifest" + inputKey);
+
+	// The manifest lists the files read by the last compilation of this input.
+	if (optional<string> manifest = m_cache->load(manifestKey))
+	{
+		Json::Value reads;
+		if (util::jsonParseStrict(*manifest, reads) && reads.isArray() && (m_readFile || reads.empty()))
+		{
+			string outputKey = inputKey;
+			for (Json::Value const& read: reads)
+			{
+				if (!read.isArray() || read.size() != 2 || !read[0].isString() || !read[1].isString())
+				{
+					outputKey.clear();
+					break;
+				}
+				string const kind = read[0].asString();
+				string const path = read[1].asString();
+				ReadCallback::Result result = m_readFile(kind, path);
+				appendToCacheKey(outputKey, kind);
+				appendToCacheKey(outputKey, path);
+				appendToCacheKey(outputKey, (result.success ? "1" : "0") + result.responseOrErrorMessage);
+			}
+			Json::Value output;
+			if (
+				optional<string> cachedOutput = outputKey.empty() ? nullopt : m_cache->load(util::keccak256("output" + outputKey));
+				cachedOutput && util::jsonParseStrict(*cachedOutput, output)
+			)
+			{
+				m_cache->recordLookup(true);
+				return output;
+			}
+		}
+	}
+	m_cache->recordLookup(false);
+
+	Json::Value reads(Json::arrayValue);
+	string outputKey = inputKey;
+	bool cacheable = true;
+	ReadCallback::Callback const readFile = m_readFile;
+	if (readFile)
+		m_readFile = [&](string const& _kind, string const& _path) {
+			ReadCallback::Result result = readFile(_kind, _path);
+			if (_kind != ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+				cacheable = false;
+			Json::Value read(Json::arrayValue);
+			read.append(_kind);
+			read.append(_path);
+			reads.append(std::move(read));
+			appendToCacheKey(outputKey, _kind);
+			appendToCacheKey(outputKey, _path);
+			appendToCacheKey(outputKey, (result.success ? "1" : "0") + result.responseOrErrorMessage);
+			return result;
+		};
+	ScopeGuard restoreReadFile([&]() { m_readFile = readFile; });
+
+	Json::Value output = compileInput(_input);
+	if (cacheable && !containsErrors(output))
+	{
+		m_cache->store(manifestKey, util::jsonCompactPrint(reads));
+		m_cache->store(util::keccak256("output" + outputKey), util::jsonCompactPrint(output));
+	}
+	return output;
+}
+
+string StandardCompiler::compile(string const& _input) noexcept
+{
+	try
+	{
+		ostringstream output;
+		compile(_input, output);
+		return output.str();
 	}
 	catch (...)
 	{
-		return formatFatalError(Error::Type::InternalCompilerError, "Internal exception in StandardCompiler::compile: " +  boost::current_exception_diagnostic_information());
+		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
 	}
 }
 
-string StandardCompiler::compile(string const& _input) noexcept
+void StandardCompiler::compile(string const& _input, ostream& _output) noexcept
 {
+	char const* writingError = "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+
 	Json::Value input;
 	string errors;
 	try
 	{
 		if (!util::jsonParseStrict(_input, input, &errors))
-			return util::jsonPrint(formatFatalError(Error::Type::JSONError, errors), m_jsonPrintingFormat);
+		{
+			_output << util::jsonPrint(formatFatalError(Error::Type::JSONError, errors), m_jsonPrintingFormat);
+			return;
+		}
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		_output << "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error parsing input JSON.\"}]}";
+		return;
+	}
+
+	if (!m_cache)
+	{
+		optional<StreamingOutputSink> sink;
+		try
+		{
+			sink.emplace(_output, m_jsonPrintingFormat);
+			compileInput(input, *sink);
+			sink->finish();
+		}
+		catch (...)
+		{
+			// The output written so far cannot be taken back, so the failure is added to its errors.
+			try
+			{
+				if (sink)
+					sink->fail(formatCurrentException());
+				else
+					_output << util::jsonPrint(formatCurrentException(), m_jsonPrintingFormat);
+			}
+			catch (...)
+			{
+				_output << writingError;
+			}
+		}
+		return;
 	}
 
-	// cout << "Input: " << input.toStyledString() << endl;
 	Json::Value output = compile(input);
-	// cout << "Output: " << output.toStyledString() << endl;
 
 	try
 	{
-		return util::jsonPrint(output, m_jsonPrintingFormat);
+		_output << util::jsonPrint(output, m_jsonPrintingFormat);
 	}
 	catch (...)
 	{
-		return "{\"errors\":[{\"type\":\"JSONError\",\"component\":\"general\",\"severity\":\"error\",\"message\":\"Error writing output JSON.\"}]}";
+		_output << writingError;
 	}
 }
 
+bool StandardCompiler::isOptimizerProfileRequested(Json::Value const& _input)
+{
+	if (!_input.isObject())
+		return false;
+	auto requested = [](Json::Value const& _settings) {
+		return _settings.isObject() && _settings["optimizerProfile"].isBool() && _settings["optimizerProfile"].asBool();
+	};
+	if (requested(_input["settings"]))
+		return true;
+	if (_input["settingsVariants"].isArray())
+		for (Json::Value const& variantSettings: _input["settingsVariants"])
+			if (requested(variantSettings))
+				return true;
+	return false;
+}
+
 Json::Value StandardCompiler::formatFunctionDebugData(
 	map<string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
 )
@@ -23,12 +23,15 @@
 
 #pragma once
 
+#include <libsolidity/interface/CompilationCache.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolutil/JSON.h>
 
 #include <liblangutil/DebugInfoSelection.h>
 
+#include <memory>
 #include <optional>
+#include <ostream>
 #include <utility>
 #include <variant>
 
@@ -62,6 +65,31 @@ public:
 	/// Parses input as JSON and peforms the above processing steps, returning a serialized JSON
 	/// output. Parsing errors are returned as regular errors.
 	std::string compile(std::string const& _input) noexcept;
+	/// Same as above, but writes the serialized output to @a _output.
+	/// Unless a cache is set, the output of each contract is written as soon as it is complete,
+	/// so that the output never has to be held in memory as a whole. If the compilation fails
+	/// after a part of the output was written, the failure is reported in its errors.
+	void compile(std::string const& _input, std::ostream& _output) noexcept;
+
+	/// Makes compile() reuse the outputs for identical inputs stored in @a _cache
+	/// and store new ones there. Only outputs without errors are stored.
+	void setCache(std::shared_ptr<CompilationCache> _cache) { m_cache = std::move(_cache); }
+
+	/// Makes compile() keep the analysis of the last Solidity input and reuse it for the next one
+	/// if that only differs in settings used by the code generator and the files read through
+	/// the callback are still the same.
+	void setReuseAnalysis(bool _reuseAnalysis)
+	{
+		m_reuseAnalysis = _reuseAnalysis;
+		if (!_reuseAnalysis)
+			m_lastAnalysis.reset();
+	}
+	/// @returns the number of compilations that reused the analysis of the previous one.
+	size_t reusedAnalyses() const { return m_reusedAnalyses; }
+
+	/// @returns true if @a _input requests the profile of the optimiser for the settings or any of
+	/// its settings variants.
+	static bool isOptimizerProfileRequested(Json::Value const& _input);
 
 	static Json::Value formatFunctionDebugData(
 		std::map<std::string, evmasm::LinkerObject::FunctionDebugData> const& _debugInfo
@@ -89,19 +117,76 @@ private:
 		Json::Value outputSelection;
 		ModelCheckerSettings modelCheckerSettings = ModelCheckerSettings{};
 		bool viaIR = false;
+		size_t parallelJobs = 1;
+		bool optimizerProfile = false;
+	};
+
+	/// Receives the output of a compilation member by member, in the order of serialization.
+	class OutputSink
+	{
+	public:
+		virtual ~OutputSink() = default;
+		/// Receives the top-level member @a _key, except for "contracts".
+		/// Called in ascending key order.
+		virtual void member(std::string const& _key, Json::Value _value) = 0;
+		/// Receives the output for contract @a _contractName in @a _sourceName, i.e. a part of the
+		/// "contracts" member. Called in ascending order of source names and then contract names.
+		virtual void contract(std::string const& _sourceName, std::string const& _contractName, Json::Value _output) = 0;
 	};
+	/// Collects the output into a JSON value.
+	class JsonOutputSink;
+	/// Serializes the output while it is produced.
+	class StreamingOutputSink;
+
+	/// The analysis kept by setReuseAnalysis.
+	struct Analysis
+	{
+		/// The input that was analyzed, apart from the settings used by the code generator.
+		InputsAndSettings inputsAndSettings;
+		/// The files read through the callback, with the response.
+		std::vector<std::pair<std::pair<std::string, std::string>, ReadCallback::Result>> reads;
+		std::unique_ptr<CompilerStack> compilerStack;
+	};
+
+	/// Passes the complete output @a _output to @a _sink.
+	static void sendOutput(Json::Value _output, OutputSink& _sink);
 
 	/// Parses the input json (and potentially invokes the read callback) and either returns
 	/// it in condensed form or an error as a json object.
 	std::variant<InputsAndSettings, Json::Value> parseInput(Json::Value const& _input);
 
 	std::map<std::string, Json::Value> parseAstFromInput(StringMap const& _sources);
-	Json::Value compileSolidity(InputsAndSettings _inputsAndSettings);
+	/// Compiles @a _input, looking up the output in m_cache first.
+	/// Files read through the callback are part of the key: the callback is queried again for
+	/// the files read by the cached compilation before using its output.
+	Json::Value compileWithCache(Json::Value const& _input);
+	Json::Value compileInput(Json::Value const& _input);
+	void compileInput(Json::Value const& _input, OutputSink& _output);
+	void compileParsedInput(InputsAndSettings _inputsAndSettings, OutputSink& _output);
+	/// Compiles the sources of @a _input once for each element of its "settingsVariants" and
+	/// outputs the results as the array "variants". Variants that only differ in code generation
+	/// settings share the parsing and analysis of the sources.
+	void compileBatch(Json::Value const& _input, OutputSink& _output);
+	/// @returns true if the Solidity inputs @a _a and @a _b only differ in settings that can be
+	/// changed after the analysis.
+	static bool sharesAnalysis(InputsAndSettings const& _a, InputsAndSettings const& _b);
+	void compileSolidity(InputsAndSettings _inputsAndSettings, OutputSink& _output);
+	/// @returns true if m_lastAnalysis can be used for compiling @a _inputsAndSettings.
+	bool canReuseLastAnalysis(InputsAndSettings const& _inputsAndSettings);
+	/// Compiles using @a _compilerStack. If the stack has already analyzed the sources with the
+	/// same analysis settings, only the code is generated again.
+	void compileSolidity(CompilerStack& _compilerStack, InputsAndSettings _inputsAndSettings, OutputSink& _output);
 	Json::Value compileYul(InputsAndSettings _inputsAndSettings);
 
 	ReadCallback::Callback m_readFile;
 
 	util::JsonFormat m_jsonPrintingFormat;
+
+	std::shared_ptr<CompilationCache> m_cache;
+
+	bool m_reuseAnalysis = false;
+	std::unique_ptr<Analysis> m_lastAnalysis;
+	size_t m_reusedAnalyses = 0;
 };
 
 }
@@ -43,9 +43,14 @@ using solidity::util::readFileAsString;
 using solidity::util::joinHumanReadable;
 using solidity::util::Result;
 
-FileRepository::FileRepository(boost::filesystem::path _basePath, std::vector<boost::filesystem::path> _includePaths):
+FileRepository::FileRepository(
+	boost::filesystem::path _basePath,
+	std::vector<boost::filesystem::path> _includePaths,
+	std::shared_ptr<DiskCache> _diskCache
+):
 	m_basePath(std::move(_basePath)),
-	m_includePaths(std::move(_includePaths))
+	m_includePaths(std::move(_includePaths)),
+	m_diskCache(std::move(_diskCache))
 {
 }
 
@@ -161,15 +166,17 @@ frontend::ReadCallback::Result FileRepository::readFile(string const& _kind, str
 		if (m_sourceCodes.count(_sourceUnitName))
 			return ReadCallback::Result{true, m_sourceCodes.at(_sourceUnitName)};
 
-		string const strippedSourceUnitName = stripFileUriSchemePrefix(_sourceUnitName);
-		Result<boost::filesystem::path> const resolvedPath = tryResolvePath(strippedSourceUnitName);
-		if (!resolvedPath.message().empty())
-			return ReadCallback::Result{false, resolvedPath.message()};
+		// Counts as unresolved until it was read successfully, also if reading throws.
+		m_unresolvedSourceUnits.insert(_sourceUnitName);
+		Result<string> contents = readFromDisk(_sourceUnitName);
+		if (!contents.message().empty())
+			return ReadCallback::Result{false, contents.message()};
+		m_unresolvedSourceUnits.erase(_sourceUnitName);
 
-		auto contents = readFileAsString(resolvedPath.get());
 		solAssert(m_sourceCodes.count(_sourceUnitName) == 0, "");
-		m_sourceCodes[_sourceUnitName] = contents;
-		return ReadCallback::Result{true, std::move(contents)};
+		m_sourceCodes[_sourceUnitName] = contents.get();
+		m_importedSourceUnits.insert(_sourceUnitName);
+		return ReadCallback::Result{true, contents.get()};
 	}
 	catch (std::exception const& _exception)
 	{
@@ -181,3 +188,74 @@ frontend::ReadCallback::Result FileRepository::readFile(string const& _kind, str
 	}
 }
 
+Result<string> FileRepository::readFromDisk(string const& _sourceUnitName) const
+{
+	Result<boost::filesystem::path> const resolvedPath = tryResolvePath(stripFileUriSchemePrefix(_sourceUnitName));
+	if (!resolvedPath.message().empty())
+		return Result<string>::err(resolvedPath.message());
+
+	return readFileFromDisk(resolvedPath.get());
+}
+
+string FileRepository::readFileFromDisk(boost::filesystem::path const& _path) const
+{
+	time_t const lastWriteTime = boost::filesystem::last_write_time(_path);
+	uintmax_t const size = boost::filesystem::file_size(_path);
+	// The modification time only has a resolution of seconds, so a file read in the second it was
+	// written to may have been changed afterwards without a different modification time.
+	if (
+		auto cached = m_diskCache->files.find(_path);
+		cached != m_diskCache->files.end() &&
+		cached->second.lastWriteTime == lastWriteTime &&
+		cached->second.size == size &&
+		lastWriteTime < cached->second.readTime
+	)
+		return cached->second.content;
+
+	time_t const readTime = time(nullptr);
+	string content = readFileAsString(_path);
+	++m_diskCache->reads;
+	m_diskCache->files[_path] = DiskCache::File{lastWriteTime, size, readTime, content};
+	return content;
+}
+
+bool FileRepository::hasSameSourcesAs(FileRepository const& _previous) const
+{
+	auto const sameOnDisk = [&](string const& _sourceUnitName, string const& _content) {
+		try
+		{
+			Result<string> currentContent = readFromDisk(_sourceUnitName);
+			return currentContent.message().empty() && currentContent.get() == _content;
+		}
+		catch (...)
+		{
+			return false;
+		}
+	};
+	auto const resolvable = [&](string const& _sourceUnitName) {
+		return m_sourceCodes.count(_sourceUnitName) || tryResolvePath(stripFileUriSchemePrefix(_sourceUnitName)).message().empty();
+	};
+
+	for (auto const& [sourceUnitName, content]: m_sourceCodes)
+		if (
+			!_previous.m_sourceCodes.count(sourceUnitName) ||
+			_previous.m_importedSourceUnits.count(sourceUnitName) ||
+			_previous.m_sourceCodes.at(sourceUnitName) != content
+		)
+			return false;
+
+	for (auto const& [sourceUnitName, content]: _previous.m_sourceCodes)
+		if (_previous.m_importedSourceUnits.count(sourceUnitName))
+		{
+			if (!sameOnDisk(sourceUnitName, content))
+				return false;
+		}
+		else if (!m_sourceCodes.count(sourceUnitName))
+			return false;
+
+	for (string const& sourceUnitName: _previous.m_unresolvedSourceUnits)
+		if (resolvable(sourceUnitName))
+			return false;
+
+	return true;
+}
@@ -20,8 +20,12 @@
 #include <libsolidity/interface/FileReader.h>
 #include <libsolutil/Result.h>
 
+#include <cstdint>
+#include <ctime>
 #include <string>
 #include <map>
+#include <memory>
+#include <set>
 
 namespace solidity::lsp
 {
@@ -29,13 +33,40 @@ namespace solidity::lsp
 class FileRepository
 {
 public:
-	FileRepository(boost::filesystem::path _basePath, std::vector<boost::filesystem::path> _includePaths);
+	/// Contents of files read from disk, which can be shared by the repositories of consecutive
+	/// compilations. A file is only read again once its size or modification time changed.
+	struct DiskCache
+	{
+		struct File
+		{
+			std::time_t lastWriteTime;
+			std::uintmax_t size;
+			/// When the file was read. Files modified in the same second are read again.
+			std::time_t readTime;
+			std::string content;
+		};
+		std::map<boost::filesystem::path, File> files;
+		/// Number of times a file was actually read from disk.
+		size_t reads = 0;
+	};
+
+	FileRepository(
+		boost::filesystem::path _basePath,
+		std::vector<boost::filesystem::path> _includePaths,
+		std::shared_ptr<DiskCache> _diskCache = std::make_shared<DiskCache>()
+	);
 
 	std::vector<boost::filesystem::path> const& includePaths() const noexcept { return m_includePaths; }
 	void setIncludePaths(std::vector<boost::filesystem::path> _paths);
 
 	boost::filesystem::path const& basePath() const { return m_basePath; }
 
+	std::shared_ptr<DiskCache> const& diskCache() const noexcept { return m_diskCache; }
+
+	/// @returns the content of the file at @a _path, which is only read if it is not in the disk
+	/// cache or changed since. Throws like util::readFileAsString.
+	std::string readFileFromDisk(boost::filesystem::path const& _path) const;
+
 	/// Translates a compiler-internal source unit name to an LSP client path.
 	std::string sourceUnitNameToUri(std::string const& _sourceUnitName) const;
 
@@ -57,7 +88,18 @@ public:
 
 	util::Result<boost::filesystem::path> tryResolvePath(std::string const& _sourceUnitName) const;
 
+	/// @returns true if compiling the sources of this repository would see exactly the same
+	/// inputs as the last compilation based on @a _previous, which is the repository that was used
+	/// for it, including the sources loaded through the import callback.
+	/// Files loaded or looked up through the import callback are resolved again against the
+	/// current base and include paths and have to have the same content as before.
+	bool hasSameSourcesAs(FileRepository const& _previous) const;
+
 private:
+	/// @returns the content of the file the given source unit name resolves to on disk,
+	/// or an error message if it cannot be resolved.
+	util::Result<std::string> readFromDisk(std::string const& _sourceUnitName) const;
+
 	/// Base path without URI scheme.
 	boost::filesystem::path m_basePath;
 
@@ -69,6 +111,14 @@ private:
 
 	/// Mapping of source unit names to their file content.
 	StringMap m_sourceCodes;
+
+	/// Source units that were not set explicitly, but loaded from disk through the import callback.
+	std::set<std::string> m_importedSourceUnits;
+
+	/// Source units requested through the import callback that could not be found.
+	std::set<std::string> m_unresolvedSourceUnits;
+
+	std::shared_ptr<DiskCache> m_diskCache;
 };
 
 }
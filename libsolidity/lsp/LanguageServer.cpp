@@ -18,6 +18,7 @@
 #include <libsolidity/ast/AST.h>
 #include <libsolidity/ast/ASTUtils.h>
 #include <libsolidity/ast/ASTVisitor.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/interface/ReadFile.h>
 #include <libsolidity/interface/StandardCompiler.h>
 #include <libsolidity/lsp/LanguageServer.h>
@@ -212,6 +213,8 @@ void LanguageServer::changeConfiguration(Json::Value const& _settings)
 		if (typeFailureCount)
 			m_client.trace("Invalid JSON configuration passed. \"include-paths\" must be an array of strings.");
 	}
+
+	m_analysisUpToDate = false;
 }
 
 vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject() const
@@ -236,12 +239,17 @@ vector<boost::filesystem::path> LanguageServer::allSolidityFilesFromProject() co
 	return collectedPaths;
 }
 
-void LanguageServer::compile()
+bool LanguageServer::compile()
 {
 	// For files that are not open, we have to take changes on disk into account,
 	// so we just remove all non-open files.
 
-	FileRepository oldRepository(m_fileRepository.basePath(), m_fileRepository.includePaths());
+	// Files on disk are only read again if they changed since the last compilation.
+	FileRepository oldRepository(
+		m_fileRepository.basePath(),
+		m_fileRepository.includePaths(),
+		m_fileRepository.diskCache()
+	);
 	swap(oldRepository, m_fileRepository);
 
 	// Load all solidity files from project.
@@ -251,7 +259,7 @@ void LanguageServer::compile()
 			lspDebug(fmt::format("adding project file: {}", projectFile.generic_string()));
 			m_fileRepository.setSourceByUri(
 				m_fileRepository.sourceUnitNameToUri(projectFile.generic_string()),
-				util::readFileAsString(projectFile)
+				m_fileRepository.readFileFromDisk(projectFile)
 			);
 		}
 
@@ -262,16 +270,27 @@ void LanguageServer::compile()
 			oldRepository.sourceUnits().at(oldRepository.uriToSourceUnitName(fileName))
 		);
 
-	// TODO: optimize! do not recompile if nothing has changed (file(s) not flagged dirty).
+	// Keep the previous analysis (and the sources loaded for it) if none of the inputs changed.
+	if (m_analysisUpToDate && m_fileRepository.hasSameSourcesAs(oldRepository))
+	{
+		swap(oldRepository, m_fileRepository);
+		return false;
+	}
 
+	// Analysis annotates the ASTs in place and CompilerStack cannot reuse the analysis of
+	// unchanged sources, so a single changed source requires analyzing all of them again.
+	m_analysisUpToDate = false;
 	m_compilerStack.reset(false);
 	m_compilerStack.setSources(m_fileRepository.sourceUnits());
 	m_compilerStack.compile(CompilerStack::State::AnalysisPerformed);
+	m_analysisUpToDate = true;
+	return true;
 }
 
 void LanguageServer::compileAndUpdateDiagnostics()
 {
-	compile();
+	size_t const diskReadsBefore = m_fileRepository.diskCache()->reads;
+	bool const analyzed = compile();
 
 	// These are the source units we will sent diagnostics to the client for sure,
 	// even if it is just to clear previous diagnostics.
@@ -314,6 +333,8 @@ void LanguageServer::compileAndUpdateDiagnostics()
 	{
 		Json::Value extra;
 		extra["openFileCount"] = Json::UInt64(diagnosticsBySourceUnit.size());
+		extra["analyzed"] = analyzed;
+		extra["filesReadFromDisk"] = Json::UInt64(m_fileRepository.diskCache()->reads - diskReadsBefore);
 		m_client.trace("Number of currently open files: " + to_string(diagnosticsBySourceUnit.size()), extra);
 	}
 
@@ -347,7 +368,11 @@ bool LanguageServer::run()
 				lspDebug(fmt::format("received method call: {}", methodName));
 
 				if (auto handler = util::valueOrDefault(m_handlers, methodName))
+				{
+					// Handlers query the types of the analyzed sources.
+					TypeProvider::Scope typeProviderScope{m_compilerStack.typeProvider()};
 					handler(id, (*jsonMessage)["params"]);
+				}
 				else
 					m_client.error(id, ErrorCode::MethodNotFound, "Unknown method " + methodName);
 			}
@@ -100,7 +100,11 @@ private:
 	void changeConfiguration(Json::Value const&);
 
 	/// Compile everything until after analysis phase.
-	void compile();
+	/// Does nothing if the sources did not change since the last call. Otherwise, all sources
+	/// are parsed and analyzed again, also the ones that did not change.
+	/// Files on disk are only read again if their size or modification time changed.
+	/// @returns false if the previous analysis was kept.
+	bool compile();
 
 	std::vector<boost::filesystem::path> allSolidityFilesFromProject() const;
 
@@ -125,6 +129,8 @@ private:
 	FileLoadStrategy m_fileLoadStrategy = FileLoadStrategy::ProjectDirectory;
 
 	frontend::CompilerStack m_compilerStack;
+	/// False until the first compilation and after every configuration change.
+	bool m_analysisUpToDate = false;
 
 	/// User-supplied custom configuration settings (such as EVM version).
 	Json::Value m_settingsObject;
@@ -22,7 +22,9 @@
 
 #include <libsolutil/JSON.h>
 
+#include <libsolutil/Assertions.h>
 #include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
 
 #include <boost/algorithm/string/replace.hpp>
 
@@ -146,4 +148,118 @@ bool jsonParseStrict(string const& _input, Json::Value& _json, string* _errs /*
 	return parse(readerBuilder, _input, _json, _errs);
 }
 
+JsonObjectStreamWriter::JsonObjectStreamWriter(ostream& _output, JsonFormat const& _format):
+	m_output(_output),
+	m_format(_format),
+	m_scopes(1)
+{
+}
+
+void JsonObjectStreamWriter::member(string const& _key, Json::Value const& _value)
+{
+	addKey(_key);
+	open();
+	writeKey(m_scopes.size() - 1, _key);
+	writeValue(jsonPrint(_value, m_format), m_scopes.size());
+}
+
+void JsonObjectStreamWriter::beginObject(string const& _key)
+{
+	addKey(_key);
+	// The object is only written once it has members, because empty objects are formatted differently.
+	m_scopes.emplace_back();
+	m_scopes.back().key = _key;
+}
+
+void JsonObjectStreamWriter::endObject()
+{
+	assertThrow(m_scopes.size() > 1, Exception, "No object to close.");
+	Scope scope = std::move(m_scopes.back());
+	m_scopes.pop_back();
+	if (scope.opened)
+	{
+		if (m_format.format == JsonFormat::Pretty)
+			m_output << "\n" << indentation(m_scopes.size());
+		m_output << "}";
+	}
+	else
+	{
+		open();
+		writeKey(m_scopes.size() - 1, scope.key);
+		writeValue("{}", m_scopes.size());
+	}
+}
+
+void JsonObjectStreamWriter::finish()
+{
+	assertThrow(!m_scopes.empty(), Exception, "Object already finished.");
+	while (m_scopes.size() > 1)
+		endObject();
+	if (!m_scopes.front().opened)
+		m_output << "{}";
+	else if (m_format.format == JsonFormat::Pretty)
+		m_output << "\n}";
+	else
+		m_output << "}";
+	m_scopes.clear();
+}
+
+void JsonObjectStreamWriter::addKey(string const& _key)
+{
+	assertThrow(!m_scopes.empty(), Exception, "Object already finished.");
+	Scope& scope = m_scopes.back();
+	assertThrow(!scope.lastKey || *scope.lastKey < _key, Exception, "Members have to be added in ascending key order.");
+	scope.lastKey = _key;
+}
+
+void JsonObjectStreamWriter::open()
+{
+	for (size_t depth = 0; depth < m_scopes.size(); ++depth)
+		if (!m_scopes[depth].opened)
+		{
+			if (depth > 0)
+			{
+				writeKey(depth - 1, m_scopes[depth].key);
+				if (m_format.format == JsonFormat::Pretty)
+					m_output << "\n" << indentation(depth);
+			}
+			m_output << "{";
+			m_scopes[depth].opened = true;
+		}
+}
+
+void JsonObjectStreamWriter::writeKey(size_t _scope, string const& _key)
+{
+	if (m_scopes[_scope].hasMembers)
+		m_output << ",";
+	m_scopes[_scope].hasMembers = true;
+	if (m_format.format == JsonFormat::Pretty)
+		m_output << "\n" << indentation(_scope + 1);
+	m_output << jsonPrint(Json::Value(_key), m_format) << ":";
+}
+
+void JsonObjectStreamWriter::writeValue(string const& _value, size_t _depth)
+{
+	if (m_format.format != JsonFormat::Pretty)
+	{
+		m_output << _value;
+		return;
+	}
+
+	// Objects and arrays spanning multiple lines start on a new line, everything else follows the key.
+	if (_value.find('\n') == string::npos)
+	{
+		m_output << " " << _value;
+		return;
+	}
+	string const newLine = "\n" + indentation(_depth);
+	m_output << newLine;
+	m_output << boost::replace_all_copy(_value, "\n", newLine);
+}
+
+string JsonObjectStreamWriter::indentation(size_t _depth) const
+{
+	return string(_depth * m_format.indent, ' ');
+}
+
 } // namespace solidity::util
@@ -25,7 +25,10 @@
 
 #include <json/json.h>
 
+#include <optional>
+#include <ostream>
 #include <string>
+#include <vector>
 
 namespace solidity::util
 {
@@ -67,6 +70,48 @@ std::string jsonPrint(Json::Value const& _input, JsonFormat const& _format);
 /// \return \c true if the document was successfully parsed, \c false if an error occurred.
 bool jsonParseStrict(std::string const& _input, Json::Value& _json, std::string* _errs = nullptr);
 
+/// Serialises a JSON object member by member, so that the values do not have to be kept in memory
+/// until the whole object is complete. The result is the same as that of jsonPrint() for the
+/// complete object, which requires the members of every object to be added in ascending key order.
+class JsonObjectStreamWriter
+{
+public:
+	/// Writes the serialised object to @a _output while it is built.
+	JsonObjectStreamWriter(std::ostream& _output, JsonFormat const& _format);
+
+	/// Adds the member @a _key with the value @a _value to the innermost open object.
+	void member(std::string const& _key, Json::Value const& _value);
+	/// Adds the member @a _key to the innermost open object and opens its value as an object.
+	void beginObject(std::string const& _key);
+	/// Closes the innermost object opened by beginObject().
+	void endObject();
+	/// Closes all open objects, including the top-level object. No members can be added afterwards.
+	void finish();
+
+private:
+	struct Scope
+	{
+		std::string key;
+		bool opened = false;
+		bool hasMembers = false;
+		std::optional<std::string> lastKey;
+	};
+
+	/// Checks that @a _key can be added to the innermost object and records it as its last key.
+	void addKey(std::string const& _key);
+	/// Writes the opening braces of all objects that have not been written yet.
+	void open();
+	/// Writes the separator and the key of a member of the object at @a _scope.
+	void writeKey(size_t _scope, std::string const& _key);
+	/// Writes a value that was serialised at the top level, indented to @a _depth.
+	void writeValue(std::string const& _value, size_t _depth);
+	std::string indentation(size_t _depth) const;
+
+	std::ostream& m_output;
+	JsonFormat m_format;
+	std::vector<Scope> m_scopes;
+};
+
 namespace detail
 {
 
@@ -22,6 +22,7 @@
 
 #include <libsolutil/Keccak256.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
 
@@ -45,16 +46,6 @@ namespace
 /******** The Keccak-f[1600] permutation ********/
 
 /*** Constants. ***/
-static uint8_t const rho[24] = \
-	{ 1,  3,   6, 10, 15, 21,
-	28, 36, 45, 55,  2, 14,
-	27, 41, 56,  8, 25, 43,
-	62, 18, 39, 61, 20, 44};
-static uint8_t const pi[24] = \
-	{10,  7, 11, 17, 18, 3,
-	5, 16,  8, 21, 24, 4,
-	15, 23, 19, 13, 12, 2,
-	20, 14, 22,  9, 6,  1};
 static uint64_t const RC[24] = \
 	{1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
 	0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
@@ -63,48 +54,78 @@ static uint64_t const RC[24] = \
 	0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL, 0x800000008000000aULL,
 	0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
 
-/*** Helper macros to unroll the permutation. ***/
-#define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
-#define REPEAT6(e) e e e e e e
-#define REPEAT24(e) REPEAT6(e e e e)
-#define REPEAT5(e) e e e e e
-#define FOR5(type, v, s, e) \
-	v = 0;            \
-	REPEAT5(e; v = static_cast<type>(v + s);)
+#if defined(__GNUC__)
+#define KECCAK_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define KECCAK_ALWAYS_INLINE inline
+#endif
 
-/*** Keccak-f[1600] ***/
-static inline void keccakf(void* state) {
-	auto* a = static_cast<uint64_t*>(state);
-	uint64_t b[5] = {0};
+/// Theta, rho, pi and chi of a single round, reading from @a _a and writing to @a _e,
+/// followed by iota with the round constant @a _rc. Lanes are indexed by x + 5 * y.
+/// The rotation offsets are literals, so that a lane can stay in a register and
+/// every rotation compiles to an immediate rotate instruction.
+/// Works for `uint64_t` and for GCC vector types of `uint64_t`, which hash several
+/// states at once (one per vector element).
+template <typename Lane>
+KECCAK_ALWAYS_INLINE void keccakRound(Lane const* _a, Lane* _e, uint64_t _rc)
+{
+#define KECCAK_ROL(v, s) (((v) << (s)) | ((v) >> (64 - (s))))
+	Lane const c0 = _a[0] ^ _a[5] ^ _a[10] ^ _a[15] ^ _a[20];
+	Lane const c1 = _a[1] ^ _a[6] ^ _a[11] ^ _a[16] ^ _a[21];
+	Lane const c2 = _a[2] ^ _a[7] ^ _a[12] ^ _a[17] ^ _a[22];
+	Lane const c3 = _a[3] ^ _a[8] ^ _a[13] ^ _a[18] ^ _a[23];
+	Lane const c4 = _a[4] ^ _a[9] ^ _a[14] ^ _a[19] ^ _a[24];
+	Lane const d0 = c4 ^ KECCAK_ROL(c1, 1);
+	Lane const d1 = c0 ^ KECCAK_ROL(c2, 1);
+	Lane const d2 = c1 ^ KECCAK_ROL(c3, 1);
+	Lane const d3 = c2 ^ KECCAK_ROL(c4, 1);
+	Lane const d4 = c3 ^ KECCAK_ROL(c0, 1);
+
+	// Every row of the output is computed from the five input lanes that pi moves into it.
+#define KECCAK_ROW(y, i0, d0, r0, i1, d1, r1, i2, d2, r2, i3, d3, r3, i4, d4, r4) \
+	{ \
+		Lane const b0 = KECCAK_ROL(_a[i0] ^ d0, r0); \
+		Lane const b1 = KECCAK_ROL(_a[i1] ^ d1, r1); \
+		Lane const b2 = KECCAK_ROL(_a[i2] ^ d2, r2); \
+		Lane const b3 = KECCAK_ROL(_a[i3] ^ d3, r3); \
+		Lane const b4 = KECCAK_ROL(_a[i4] ^ d4, r4); \
+		_e[5 * y + 0] = b0 ^ (~b1 & b2); \
+		_e[5 * y + 1] = b1 ^ (~b2 & b3); \
+		_e[5 * y + 2] = b2 ^ (~b3 & b4); \
+		_e[5 * y + 3] = b3 ^ (~b4 & b0); \
+		_e[5 * y + 4] = b4 ^ (~b0 & b1); \
+	}
+	{
+		// Lane 0 is not rotated.
+		Lane const b0 = _a[0] ^ d0;
+		Lane const b1 = KECCAK_ROL(_a[6] ^ d1, 44);
+		Lane const b2 = KECCAK_ROL(_a[12] ^ d2, 43);
+		Lane const b3 = KECCAK_ROL(_a[18] ^ d3, 21);
+		Lane const b4 = KECCAK_ROL(_a[24] ^ d4, 14);
+		_e[0] = b0 ^ (~b1 & b2) ^ _rc;
+		_e[1] = b1 ^ (~b2 & b3);
+		_e[2] = b2 ^ (~b3 & b4);
+		_e[3] = b3 ^ (~b4 & b0);
+		_e[4] = b4 ^ (~b0 & b1);
+	}
+	KECCAK_ROW(1, 3, d3, 28, 9, d4, 20, 10, d0, 3, 16, d1, 45, 22, d2, 61)
+	KECCAK_ROW(2, 1, d1, 1, 7, d2, 6, 13, d3, 25, 19, d4, 8, 20, d0, 18)
+	KECCAK_ROW(3, 4, d4, 27, 5, d0, 36, 11, d1, 10, 17, d2, 15, 23, d3, 56)
+	KECCAK_ROW(4, 2, d2, 62, 8, d3, 55, 14, d4, 39, 15, d0, 41, 21, d1, 2)
+#undef KECCAK_ROW
+#undef KECCAK_ROL
+}
 
-	for (int i = 0; i < 24; i++)
+/*** Keccak-f[1600] ***/
+template <typename Lane>
+KECCAK_ALWAYS_INLINE void keccakf(Lane* _state)
+{
+	// Alternates between the state and a temporary copy to avoid copying back after every round.
+	Lane temporary[25];
+	for (size_t round = 0; round < 24; round += 2)
 	{
-		uint8_t x, y;
-		// Theta
-		FOR5(uint8_t, x, 1,
-			b[x] = 0;
-			FOR5(uint8_t, y, 5,
-				b[x] ^= a[x + y]; ))
-		FOR5(uint8_t, x, 1,
-			FOR5(uint8_t, y, 5,
-				a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1); ))
-		// Rho and pi
-		uint64_t t = a[1];
-		x = 0;
-		REPEAT24(b[0] = a[pi[x]];
-				a[pi[x]] = rol(t, rho[x]);
-				t = b[0];
-				x++; )
-		// Chi
-		FOR5(uint8_t,
-			y,
-			5,
-			FOR5(uint8_t, x, 1,
-				b[x] = a[y + x];)
-			FOR5(uint8_t, x, 1,
-				a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]); ))
-		// Iota
-		a[0] ^= RC[i];
+		keccakRound(_state, temporary, RC[round]);
+		keccakRound(temporary, _state, RC[round + 1]);
 	}
 }
 
@@ -131,14 +152,19 @@ static inline void keccakf(void* state) {
 mkapply_ds(xorin, dst[i] ^= src[i])  // xorin
 mkapply_sd(setout, dst[i] = src[i])  // setout
 
-#define P keccakf
+void keccakf1600(uint64_t* _state)
+{
+	keccakf(_state);
+}
+
+#define P keccakf1600
 #define Plen 200
 
 // Fold P*F over the full blocks of an input.
 #define foldP(I, L, F) \
 	while (L >= rate) {  \
 		F(a, I, rate);     \
-		P(a);              \
+		P(state);          \
 		I += rate;         \
 		L -= rate;         \
 	}
@@ -153,7 +179,9 @@ inline void hash(
 	uint8_t delim
 )
 {
-	uint8_t a[Plen] = {0};
+	uint64_t state[Plen / 8] = {0};
+	// Byte-wise view of the state. Like the lanes, it assumes a little-endian target.
+	uint8_t* a = reinterpret_cast<uint8_t*>(state);
 	// Absorb input.
 	foldP(in, inlen, xorin);
 	// Xor in the DS and pad frame.
@@ -162,13 +190,68 @@ inline void hash(
 	// Xor in the last block.
 	xorin(a, in, inlen);
 	// Apply P
-	P(a);
+	P(state);
 	// Squeeze output.
 	foldP(out, outlen, setout);
 	setout(a, out, outlen);
-	memset(a, 0, 200);
+	memset(a, 0, Plen);
 }
 
+size_t constexpr keccak256Rate = 200 - (256 / 4);
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define KECCAK_AVX2
+
+/// Four 64 bit lanes, one of each of four independent states.
+typedef uint64_t Lanes4 __attribute__((vector_size(32)));
+
+/// Copies block @a _block of @a _input (padded if it is the last one) into @a _lanes.
+void loadBlock(bytesConstRef _input, size_t _block, uint64_t* _lanes)
+{
+	size_t const offset = _block * keccak256Rate;
+	if (offset + keccak256Rate <= _input.size())
+		memcpy(_lanes, _input.data() + offset, keccak256Rate);
+	else
+	{
+		auto* bytes = reinterpret_cast<uint8_t*>(_lanes);
+		size_t const remaining = _input.size() - offset;
+		memset(bytes, 0, keccak256Rate);
+		if (remaining > 0)
+			memcpy(bytes, _input.data() + offset, remaining);
+		bytes[remaining] ^= 0x01;
+		bytes[keccak256Rate - 1] ^= 0x80;
+	}
+}
+
+/// Hashes the four inputs at @a _indices, which all consist of @a _blocks blocks after padding,
+/// running the four permutations in parallel in the lanes of AVX2 registers.
+__attribute__((target("avx2")))
+void keccak256x4(
+	vector<bytesConstRef> const& _inputs,
+	size_t const* _indices,
+	size_t _blocks,
+	vector<h256>& _outputs
+)
+{
+	Lanes4 state[25] = {};
+	uint64_t lanes[4][keccak256Rate / 8];
+	for (size_t block = 0; block < _blocks; ++block)
+	{
+		for (size_t i = 0; i < 4; ++i)
+			loadBlock(_inputs[_indices[i]], block, lanes[i]);
+		for (size_t lane = 0; lane < keccak256Rate / 8; ++lane)
+			state[lane] ^= Lanes4{lanes[0][lane], lanes[1][lane], lanes[2][lane], lanes[3][lane]};
+		keccakf(state);
+	}
+	for (size_t i = 0; i < 4; ++i)
+		for (size_t lane = 0; lane < 4; ++lane)
+		{
+			uint64_t const value = state[lane][i];
+			memcpy(_outputs[_indices[i]].data() + 8 * lane, &value, 8);
+		}
+}
+#endif
+
 }
 
 h256 keccak256(bytesConstRef _input)
@@ -178,8 +261,46 @@ h256 keccak256(bytesConstRef _input)
 	// The 0x01 is the specific padding for keccak (sha3 uses 0x06) and
 	// the way the round size (or window or whatever it was) is calculated.
 	// 200 - (256 / 4) is the "rate"
-	hash(output.data(), output.size, _input.data(), _input.size(), 200 - (256 / 4), 0x01);
+	hash(output.data(), output.size, _input.data(), _input.size(), keccak256Rate, 0x01);
 	return output;
 }
 
+vector<h256> keccak256(vector<bytesConstRef> const& _inputs)
+{
+	vector<h256> outputs(_inputs.size());
+	vector<size_t> remaining;
+#if defined(KECCAK_AVX2)
+	if (_inputs.size() >= 4 && __builtin_cpu_supports("avx2"))
+	{
+		// Groups the inputs by the number of permutations they need, so that they
+		// can be hashed four at a time.
+		auto blocks = [](bytesConstRef _input) { return _input.size() / keccak256Rate + 1; };
+		vector<size_t> indices(_inputs.size());
+		for (size_t i = 0; i < indices.size(); ++i)
+			indices[i] = i;
+		stable_sort(indices.begin(), indices.end(), [&](size_t _a, size_t _b) {
+			return blocks(_inputs[_a]) < blocks(_inputs[_b]);
+		});
+		size_t i = 0;
+		while (i < indices.size())
+		{
+			size_t const count = blocks(_inputs[indices[i]]);
+			if (i + 4 <= indices.size() && blocks(_inputs[indices[i + 3]]) == count)
+			{
+				keccak256x4(_inputs, &indices[i], count, outputs);
+				i += 4;
+			}
+			else
+				remaining.push_back(indices[i++]);
+		}
+	}
+	else
+#endif
+		for (size_t i = 0; i < _inputs.size(); ++i)
+			remaining.push_back(i);
+	for (size_t i: remaining)
+		outputs[i] = keccak256(_inputs[i]);
+	return outputs;
+}
+
 }
@@ -65,6 +65,9 @@ public:
 		_other.m_value.reset();
 	}
 
+	/// Discards the stored value, so that the next call to "init" computes it again.
+	void reset() { m_value.reset(); }
+
 	template<typename F>
 	value_type& init(F&& _fun)
 	{
@@ -0,0 +1,110 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+
+void util::parallelFor(size_t _jobs, size_t _count, function<void(size_t)> const& _task)
+{
+	atomic<size_t> nextIndex{0};
+	auto worker = [&]() {
+		for (size_t index = nextIndex++; index < _count; index = nextIndex++)
+			_task(index);
+	};
+
+	vector<thread> workers;
+	for (size_t i = 1; i < min(_jobs, _count); ++i)
+		workers.emplace_back(worker);
+	worker();
+	for (thread& workerThread: workers)
+		workerThread.join();
+}
+
+util::WorkerPool::WorkerPool(size_t _jobs)
+{
+	for (size_t i = 1; i < _jobs; ++i)
+		m_threads.emplace_back([this]() { work(); });
+}
+
+util::WorkerPool::~WorkerPool()
+{
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_stopping = true;
+	}
+	m_runStarted.notify_all();
+	for (thread& workerThread: m_threads)
+		workerThread.join();
+}
+
+void util::WorkerPool::run(size_t _count, function<void(size_t)> const& _task)
+{
+	if (m_threads.empty() || _count <= 1)
+	{
+		for (size_t index = 0; index < _count; ++index)
+			_task(index);
+		return;
+	}
+
+	{
+		lock_guard<mutex> lock(m_mutex);
+		m_task = &_task;
+		m_count = _count;
+		m_nextIndex = 0;
+		m_busyThreads = m_threads.size();
+		++m_run;
+	}
+	m_runStarted.notify_all();
+	runTasks();
+
+	unique_lock<mutex> lock(m_mutex);
+	m_runFinished.wait(lock, [&]() { return m_busyThreads == 0; });
+	m_task = nullptr;
+}
+
+void util::WorkerPool::work()
+{
+	size_t lastRun = 0;
+	while (true)
+	{
+		{
+			unique_lock<mutex> lock(m_mutex);
+			m_runStarted.wait(lock, [&]() { return m_stopping || m_run != lastRun; });
+			if (m_stopping)
+				return;
+			lastRun = m_run;
+		}
+		runTasks();
+		lock_guard<mutex> lock(m_mutex);
+		if (--m_busyThreads == 0)
+			m_runFinished.notify_one();
+	}
+}
+
+void util::WorkerPool::runTasks()
+{
+	for (size_t index = m_nextIndex++; index < m_count; index = m_nextIndex++)
+		(*m_task)(index);
+}
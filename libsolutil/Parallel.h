@@ -0,0 +1,82 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Minimal worker pool for running independent tasks concurrently.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace solidity::util
+{
+
+/// Calls @a _task once for every index in [0, @a _count), using up to @a _jobs threads
+/// (including the calling one). Indices are handed out in increasing order, but tasks may
+/// finish in any order, so @a _task has to store its results per index.
+/// With @a _jobs <= 1 everything runs sequentially on the calling thread.
+/// @a _task must not throw; capture exceptions with std::current_exception() instead.
+void parallelFor(size_t _jobs, size_t _count, std::function<void(size_t)> const& _task);
+
+/**
+ * Threads that are kept for running tasks like parallelFor several times, so that neither the
+ * threads nor the data they keep in thread_local variables are created again for each run.
+ */
+class WorkerPool
+{
+public:
+	/// Starts @a _jobs - 1 threads. The thread calling run() is the remaining one.
+	explicit WorkerPool(size_t _jobs);
+	~WorkerPool();
+
+	WorkerPool(WorkerPool const&) = delete;
+	WorkerPool& operator=(WorkerPool const&) = delete;
+
+	/// @returns the number of threads running tasks, including the calling one.
+	size_t jobs() const { return m_threads.size() + 1; }
+
+	/// Like parallelFor, but on the threads of the pool. Must not be called concurrently.
+	void run(size_t _count, std::function<void(size_t)> const& _task);
+
+private:
+	void work();
+	void runTasks();
+
+	std::mutex m_mutex;
+	/// Notified when a run starts or the pool is destroyed.
+	std::condition_variable m_runStarted;
+	/// Notified when the last thread of the pool is done with the current run.
+	std::condition_variable m_runFinished;
+	std::function<void(size_t)> const* m_task = nullptr;
+	size_t m_count = 0;
+	std::atomic<size_t> m_nextIndex{0};
+	/// Number of the current run, so that every thread takes part in each run once.
+	size_t m_run = 0;
+	/// Threads of the pool that are not done with the current run yet.
+	size_t m_busyThreads = 0;
+	bool m_stopping = false;
+	std::vector<std::thread> m_threads;
+};
+
+}
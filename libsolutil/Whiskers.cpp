@@ -26,15 +26,212 @@
 
 #include <libsolutil/Assertions.h>
 
-#include <regex>
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <unordered_map>
 
 using namespace std;
 using namespace solidity::util;
 
+namespace
+{
+
+bool isParameterCharacter(char _c)
+{
+	return
+		('a' <= _c && _c <= 'z') ||
+		('A' <= _c && _c <= 'Z') ||
+		('0' <= _c && _c <= '9') ||
+		_c == '_' || _c == '$' || _c == '-';
+}
+
+/// @returns the end of the parameter name starting at @a _pos, which is @a _pos if there is none.
+size_t parameterEnd(string const& _text, size_t _pos, size_t _end)
+{
+	while (_pos < _end && isParameterCharacter(_text[_pos]))
+		++_pos;
+	return _pos;
+}
+
+/// @returns the position of the first occurrence of @a _tag in [_pos, _end) or string::npos.
+size_t findTag(string const& _text, string const& _tag, size_t _pos, size_t _end)
+{
+	size_t position = _text.find(_tag, _pos);
+	return (position != string::npos && position + _tag.size() <= _end) ? position : string::npos;
+}
+
+bool startsWithTag(string const& _text, string const& _tag, size_t _pos, size_t _end)
+{
+	return _pos + _tag.size() <= _end && _text.compare(_pos, _tag.size(), _tag) == 0;
+}
+
+}
+
+/**
+ * A template parsed into a flat list of instructions. The instructions of the body of a list
+ * or condition directly follow it.
+ */
+struct Whiskers::Template
+{
+	enum class Kind { Text, Tag, List, Condition };
+	struct Instruction
+	{
+		Kind kind;
+		/// Name of the parameter, with a leading "+" for conditions on values.
+		string name;
+		/// Text: the text to copy. List: the body. Condition: the first branch.
+		size_t textBegin = 0;
+		size_t textEnd = 0;
+		/// Condition: the second branch.
+		size_t elseTextBegin = 0;
+		size_t elseTextEnd = 0;
+		/// List: end of the instructions of the body. Condition: end of the instructions of the
+		/// first branch, which are followed by those of the second branch.
+		size_t bodyEnd = 0;
+		/// Condition: end of the instructions of the second branch.
+		size_t elseEnd = 0;
+	};
+
+	explicit Template(string _text): text(std::move(_text))
+	{
+		scanTags();
+		parse(0, text.size());
+	}
+
+	/// Collects the tags of the form <name>, <?name>, </name> and <#name> and checks that tags
+	/// starting with #, ?, ! or / are closed.
+	void scanTags();
+	/// Appends the instructions for the part [_begin, _end) of the text.
+	void parse(size_t _begin, size_t _end);
+
+	string const text;
+	vector<Instruction> instructions;
+	/// The tags found in the text, without the angle brackets.
+	set<string> tags;
+};
+
+void Whiskers::Template::scanTags()
+{
+	for (size_t pos = text.find('<'); pos != string::npos; pos = text.find('<', pos + 1))
+	{
+		size_t nameBegin = pos + 1;
+		if (nameBegin < text.size() && string_view("#?!/").find(text[nameBegin]) != string_view::npos)
+		{
+			++nameBegin;
+			// Conditions on values are only valid with ? and !, but the closing tag is checked for all.
+			size_t valueNameBegin = nameBegin + (nameBegin < text.size() && text[nameBegin] == '+' ? 1 : 0);
+			size_t valueNameEnd = parameterEnd(text, valueNameBegin, text.size());
+			assertThrow(
+				valueNameEnd == valueNameBegin || (valueNameEnd < text.size() && text[valueNameEnd] == '>'),
+				WhiskersError,
+				"Template contains an invalid/unclosed tag " + text.substr(pos, min(valueNameEnd + 1, text.size()) - pos)
+			);
+			if (text[pos + 1] == '!')
+				continue;
+		}
+		size_t nameEnd = parameterEnd(text, nameBegin, text.size());
+		if (nameEnd != nameBegin && nameEnd < text.size() && text[nameEnd] == '>')
+			tags.insert(text.substr(pos + 1, nameEnd - pos - 1));
+	}
+}
+
+void Whiskers::Template::parse(size_t _begin, size_t _end)
+{
+	size_t textBegin = _begin;
+	auto addText = [&](size_t _textEnd) {
+		if (_textEnd > textBegin)
+			instructions.push_back({Kind::Text, {}, textBegin, _textEnd});
+	};
+
+	for (size_t pos = text.find('<', _begin); pos < _end; pos = text.find('<', pos))
+	{
+		char prefix = pos + 1 < _end ? text[pos + 1] : '\0';
+		if (isParameterCharacter(prefix))
+		{
+			// <name>
+			size_t nameEnd = parameterEnd(text, pos + 1, _end);
+			if (nameEnd < _end && text[nameEnd] == '>')
+			{
+				addText(pos);
+				instructions.push_back({Kind::Tag, text.substr(pos + 1, nameEnd - pos - 1)});
+				pos = textBegin = nameEnd + 1;
+				continue;
+			}
+		}
+		else if (prefix == '#')
+		{
+			// <#name>...</name>, up to the first closing tag.
+			size_t nameEnd = parameterEnd(text, pos + 2, _end);
+			if (nameEnd != pos + 2 && nameEnd < _end && text[nameEnd] == '>')
+			{
+				string name = text.substr(pos + 2, nameEnd - pos - 2);
+				string closingTag = "</" + name + ">";
+				size_t closingPos = findTag(text, closingTag, nameEnd + 1, _end);
+				if (closingPos != string::npos)
+				{
+					addText(pos);
+					size_t index = instructions.size();
+					instructions.push_back({Kind::List, std::move(name), nameEnd + 1, closingPos});
+					parse(nameEnd + 1, closingPos);
+					instructions[index].bodyEnd = instructions.size();
+					pos = textBegin = closingPos + closingTag.size();
+					continue;
+				}
+			}
+		}
+		else if (prefix == '?')
+		{
+			// <?name>...<!name>...</name> or <?name>...</name>, where the first branch ends at the
+			// first "<!name>" that is followed by a closing tag or at the first closing tag.
+			size_t nameBegin = pos + 2 + (pos + 2 < _end && text[pos + 2] == '+' ? 1 : 0);
+			size_t nameEnd = parameterEnd(text, nameBegin, _end);
+			if (nameEnd != nameBegin && nameEnd < _end && text[nameEnd] == '>')
+			{
+				string name = text.substr(pos + 2, nameEnd - pos - 2);
+				string elseTag = "<!" + name + ">";
+				string closingTag = "</" + name + ">";
+				size_t bodyBegin = nameEnd + 1;
+				size_t elsePos = string::npos;
+				size_t closingPos = string::npos;
+				for (
+					size_t candidate = text.find('<', bodyBegin);
+					candidate < _end && closingPos == string::npos;
+					candidate = text.find('<', candidate + 1)
+				)
+					if (startsWithTag(text, elseTag, candidate, _end))
+					{
+						closingPos = findTag(text, closingTag, candidate + elseTag.size(), _end);
+						if (closingPos != string::npos)
+							elsePos = candidate;
+					}
+					else if (startsWithTag(text, closingTag, candidate, _end))
+						closingPos = candidate;
+
+				if (closingPos != string::npos)
+				{
+					addText(pos);
+					size_t index = instructions.size();
+					size_t bodyEnd = elsePos != string::npos ? elsePos : closingPos;
+					size_t elseBegin = elsePos != string::npos ? elsePos + elseTag.size() : closingPos;
+					instructions.push_back({Kind::Condition, std::move(name), bodyBegin, bodyEnd, elseBegin, closingPos});
+					parse(bodyBegin, bodyEnd);
+					instructions[index].bodyEnd = instructions.size();
+					parse(elseBegin, closingPos);
+					instructions[index].elseEnd = instructions.size();
+					pos = textBegin = closingPos + closingTag.size();
+					continue;
+				}
+			}
+		}
+		++pos;
+	}
+	addText(_end);
+}
+
 Whiskers::Whiskers(string _template):
-	m_template(std::move(_template))
+	m_template(parse(std::move(_template)))
 {
-	checkTemplateValid();
 }
 
 Whiskers& Whiskers::operator()(string _parameter, string _value)
@@ -72,25 +269,19 @@ Whiskers& Whiskers::operator()(
 
 string Whiskers::render() const
 {
-	return replace(m_template, m_parameters, m_conditions, m_listParameters);
-}
-
-void Whiskers::checkTemplateValid() const
-{
-	regex validTemplate("<[#?!\\/]\\+{0,1}[a-zA-Z0-9_$-]+(?:[^a-zA-Z0-9_$>-]|$)");
-	smatch match;
-	assertThrow(
-		!regex_search(m_template, match, validTemplate),
-		WhiskersError,
-		"Template contains an invalid/unclosed tag " + match.str()
-	);
+	size_t size = m_template->text.size();
+	for (auto const& parameter: m_parameters)
+		size += parameter.second.size();
+	string result;
+	result.reserve(size);
+	render(result, 0, m_template->instructions.size(), m_template->text, nullptr);
+	return result;
 }
 
 void Whiskers::checkParameterValid(string const& _parameter) const
 {
-	static regex validParam("^" + paramRegex() + "$");
 	assertThrow(
-		regex_match(_parameter, validParam),
+		!_parameter.empty() && all_of(_parameter.begin(), _parameter.end(), isParameterCharacter),
 		WhiskersError,
 		"Parameter" + _parameter + " contains invalid characters."
 	);
@@ -118,127 +309,141 @@ void Whiskers::checkParameterUnknown(string const& _parameter) const
 void Whiskers::checkTemplateContainsTags(string const& _parameter, vector<string> const& _prefixes) const
 {
 	for (auto const& prefix: _prefixes)
-	{
-		string tag{"<" + prefix + _parameter + ">"};
 		assertThrow(
-			m_template.find(tag) != string::npos,
+			m_template->tags.count(prefix + _parameter),
 			WhiskersError,
-			"Tag '" + tag + "' not found in template:\n" + m_template
+			"Tag '<" + prefix + _parameter + ">' not found in template:\n" + m_template->text
 		);
-	}
 }
 
-namespace
+shared_ptr<Whiskers::Template const> Whiskers::parse(string _template)
 {
-template<class ReplaceCallback>
-string regex_replace(
-	string const& _source,
-	regex const& _pattern,
-	ReplaceCallback _replace,
-	regex_constants::match_flag_type _flags = regex_constants::match_default
-)
-{
-	sregex_iterator curMatch(_source.begin(), _source.end(), _pattern, _flags);
-	sregex_iterator matchEnd;
-	string::const_iterator lastMatchedPos(_source.cbegin());
-	string result;
-	while (curMatch != matchEnd)
+	// Templates are mostly string literals, so the number of distinct ones is small. The limit
+	// only protects against templates generated from data.
+	static size_t const maxCachedTemplates = 4096;
+	static mutex cacheMutex;
+	static unordered_map<string, shared_ptr<Template const>> cache;
+
 	{
-		result.append(curMatch->prefix().first, curMatch->prefix().second);
-		result.append(_replace(*curMatch));
-		lastMatchedPos = (*curMatch)[0].second;
-		++curMatch;
+		lock_guard<mutex> lock(cacheMutex);
+		if (auto cached = cache.find(_template); cached != cache.end())
+			return cached->second;
 	}
-	result.append(lastMatchedPos, _source.cend());
-	return result;
-}
+
+	auto parsed = make_shared<Template const>(std::move(_template));
+	lock_guard<mutex> lock(cacheMutex);
+	if (cache.size() >= maxCachedTemplates)
+		cache.clear();
+	cache.emplace(parsed->text, parsed);
+	return parsed;
 }
 
-string Whiskers::replace(
-	string const& _template,
-	StringMap const& _parameters,
-	map<string, bool> const& _conditions,
-	map<string, vector<StringMap>> const& _listParameters
-)
+void Whiskers::render(
+	string& _output,
+	size_t _begin,
+	size_t _end,
+	string_view _source,
+	StringMap const* _listElement
+) const
 {
-	static regex listOrTag(
-		"<(" + paramRegex() + ")>|"
-		"<#(" + paramRegex() + ")>((?:.|\\r|\\n)*?)</\\2>|"
-		"<\\?(\\+?" + paramRegex() + ")>((?:.|\\r|\\n)*?)(<!\\4>((?:.|\\r|\\n)*?))?</\\4>"
-	);
-	return regex_replace(_template, listOrTag, [&](match_results<string::const_iterator> _match) -> string
+	string const& text = m_template->text;
+	auto findParameter = [&](string const& _name) -> string const* {
+		if (_listElement)
+			if (auto value = _listElement->find(_name); value != _listElement->end())
+				return &value->second;
+		if (auto value = m_parameters.find(_name); value != m_parameters.end())
+			return &value->second;
+		return nullptr;
+	};
+	auto findList = [&](string const& _name) -> vector<StringMap> const* {
+		if (_listElement)
+			return nullptr;
+		auto values = m_listParameters.find(_name);
+		return values != m_listParameters.end() ? &values->second : nullptr;
+	};
+
+	for (size_t index = _begin; index < _end;)
 	{
-		string tagName(_match[1]);
-		string listName(_match[2]);
-		string conditionName(_match[4]);
-		if (!tagName.empty())
+		Template::Instruction const& instruction = m_template->instructions[index];
+		switch (instruction.kind)
+		{
+		case Template::Kind::Text:
+			_output.append(text, instruction.textBegin, instruction.textEnd - instruction.textBegin);
+			++index;
+			break;
+		case Template::Kind::Tag:
 		{
+			string const* value = findParameter(instruction.name);
 			assertThrow(
-				_parameters.count(tagName),
+				value,
 				WhiskersError,
-				"Value for tag " + tagName + " not provided.\n" +
+				"Value for tag " + instruction.name + " not provided.\n" +
 				"Template:\n" +
-				_template
+				string(_source)
 			);
-			return _parameters.at(tagName);
+			_output += *value;
+			++index;
+			break;
 		}
-		else if (!listName.empty())
+		case Template::Kind::List:
 		{
-			string templ(_match[3]);
-			assertThrow(
-				_listParameters.count(listName),
-				WhiskersError, "List parameter " + listName + " not set."
-			);
-			string replacement;
-			for (auto const& parameters: _listParameters.at(listName))
-				replacement += replace(templ, joinMaps(_parameters, parameters), _conditions);
-			return replacement;
+			vector<StringMap> const* elements = findList(instruction.name);
+			assertThrow(elements, WhiskersError, "List parameter " + instruction.name + " not set.");
+			string_view body(text.data() + instruction.textBegin, instruction.textEnd - instruction.textBegin);
+			for (StringMap const& element: *elements)
+			{
+				for (auto const& parameter: element)
+					assertThrow(
+						!(_listElement ? _listElement->count(parameter.first) : 0) && !m_parameters.count(parameter.first),
+						WhiskersError,
+						"Parameter collision"
+					);
+				render(_output, index + 1, instruction.bodyEnd, body, &element);
+			}
+			index = instruction.bodyEnd;
+			break;
 		}
-		else
+		case Template::Kind::Condition:
 		{
-			assertThrow(!conditionName.empty(), WhiskersError, "");
 			bool conditionValue = false;
-			if (conditionName[0] == '+')
+			if (instruction.name[0] == '+')
 			{
-				string tag = conditionName.substr(1);
-
-				if (_parameters.count(tag))
-					conditionValue = !_parameters.at(tag).empty();
-				else if (_listParameters.count(tag))
-					conditionValue = !_listParameters.at(tag).empty();
+				string tag = instruction.name.substr(1);
+				if (string const* value = findParameter(tag))
+					conditionValue = !value->empty();
+				else if (vector<StringMap> const* elements = findList(tag))
+					conditionValue = !elements->empty();
 				else
 					assertThrow(false, WhiskersError, "Tag " + tag + " used as condition but was not set.");
 			}
 			else
 			{
+				auto condition = m_conditions.find(instruction.name);
 				assertThrow(
-					_conditions.count(conditionName),
-					WhiskersError, "Condition parameter " + conditionName + " not set."
+					condition != m_conditions.end(),
+					WhiskersError, "Condition parameter " + instruction.name + " not set."
 				);
-				conditionValue = _conditions.at(conditionName);
+				conditionValue = condition->second;
 			}
-			return replace(
-				conditionValue ? _match[5] : _match[7],
-				_parameters,
-				_conditions,
-				_listParameters
-			);
+			if (conditionValue)
+				render(
+					_output,
+					index + 1,
+					instruction.bodyEnd,
+					string_view(text.data() + instruction.textBegin, instruction.textEnd - instruction.textBegin),
+					_listElement
+				);
+			else
+				render(
+					_output,
+					instruction.bodyEnd,
+					instruction.elseEnd,
+					string_view(text.data() + instruction.elseTextBegin, instruction.elseTextEnd - instruction.elseTextBegin),
+					_listElement
+				);
+			index = instruction.elseEnd;
+			break;
 		}
-	});
-}
-
-Whiskers::StringMap Whiskers::joinMaps(
-	Whiskers::StringMap const& _a,
-	Whiskers::StringMap const& _b
-)
-{
-	Whiskers::StringMap ret = _a;
-	for (auto const& x: _b)
-		assertThrow(
-			ret.insert(x).second,
-			WhiskersError,
-			"Parameter collision"
-		);
-	return ret;
+		}
+	}
 }
-
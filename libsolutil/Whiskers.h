@@ -26,8 +26,10 @@
 
 #include <libsolutil/Exceptions.h>
 
-#include <string>
 #include <map>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace solidity::util
@@ -67,6 +69,9 @@ DEV_SIMPLE_EXCEPTION(WhiskersError);
  *    Works similar to a conditional parameter where the checked condition is
  *    that the string or list parameter called "name" is non-empty or contains
  *    no elements respectively.
+ *
+ * Templates are parsed once into a list of instructions that is shared by all instances
+ * using the same template text.
  */
 class Whiskers
 {
@@ -90,31 +95,35 @@ public:
 	std::string render() const;
 
 private:
+	/// Parsed template, defined in Whiskers.cpp.
+	struct Template;
+
 	// Prevent implicit cast to bool
 	Whiskers& operator()(std::string _parameter, long long);
-	void checkTemplateValid() const;
 	void checkParameterValid(std::string const& _parameter) const;
 	void checkParameterUnknown(std::string const& _parameter) const;
 
-	/// Checks whether the string stored in `m_template` contains all the tags specified.
+	/// Checks whether the template contains all the tags specified.
 	/// @param _parameter name of the parameter. This name is used to construct the tag(s).
 	/// @param _prefixes a vector of strings, where each element is used to compose the tag
 	///        like `"<" + element + _parameter + ">"`. Each element of _prefixes is used as a prefix of the tag name.
 	void checkTemplateContainsTags(std::string const& _parameter, std::vector<std::string> const& _prefixes) const;
 
-	static std::string replace(
-		std::string const& _template,
-		StringMap const& _parameters,
-		std::map<std::string, bool> const& _conditions,
-		StringListMap const& _listParameters = StringListMap()
-	);
-
-	static std::string paramRegex() { return "[a-zA-Z0-9_$-]+"; }
-
-	/// Joins the two maps throwing an exception if two keys are equal.
-	static StringMap joinMaps(StringMap const& _a, StringMap const& _b);
-
-	std::string m_template;
+	/// @returns the parsed template for @a _template, reusing the result of earlier calls.
+	static std::shared_ptr<Template const> parse(std::string _template);
+
+	/// Appends the result of the instructions in [_begin, _end) to @a _output. @a _source is the part
+	/// of the template they were parsed from. Inside a list, @a _listElement holds the parameters of
+	/// the current element and list parameters are not available.
+	void render(
+		std::string& _output,
+		size_t _begin,
+		size_t _end,
+		std::string_view _source,
+		StringMap const* _listElement
+	) const;
+
+	std::shared_ptr<Template const> m_template;
 	StringMap m_parameters;
 	std::map<std::string, bool> m_conditions;
 	StringListMap m_listParameters;
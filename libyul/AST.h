@@ -28,8 +28,10 @@
 
 #include <liblangutil/SourceLocation.h>
 
+#include <map>
 #include <memory>
 #include <optional>
+#include <tuple>
 
 namespace solidity::yul
 {
@@ -48,12 +50,21 @@ struct DebugData
 		astID(std::move(_astID))
 	{}
 
+	/// @returns debug data with the given content. Debug data without any content is
+	/// shared by all callers, since the optimiser creates a lot of it for new nodes.
 	static std::shared_ptr<DebugData const> create(
 		langutil::SourceLocation _nativeLocation = {},
 		langutil::SourceLocation _originLocation = {},
 		std::optional<int64_t> _astID = {}
 	)
 	{
+		if (!_nativeLocation.isValid() && !_originLocation.isValid() && !_astID)
+		{
+			static std::shared_ptr<DebugData const> const empty = std::make_shared<DebugData const>(
+				langutil::SourceLocation{}
+			);
+			return empty;
+		}
 		return std::make_shared<DebugData const>(
 			std::move(_nativeLocation),
 			std::move(_originLocation),
@@ -70,6 +81,42 @@ struct DebugData
 	std::optional<int64_t> astID;
 };
 
+/**
+ * Table of the debug data of one Yul object. Nodes with equal debug data share
+ * a single entry instead of each holding its own copy.
+ * Source names are compared by identity, which is sufficient because all locations
+ * of one object refer to the same source name strings. The entries keep these strings
+ * alive, so their addresses cannot be reused while the table exists.
+ */
+class DebugDataTable
+{
+public:
+	/// @returns the entry with the given content, which is created if it does not exist yet.
+	std::shared_ptr<DebugData const> get(
+		langutil::SourceLocation _nativeLocation = {},
+		langutil::SourceLocation _originLocation = {},
+		std::optional<int64_t> _astID = {}
+	)
+	{
+		Key key{
+			_nativeLocation.sourceName.get(), _nativeLocation.start, _nativeLocation.end,
+			_originLocation.sourceName.get(), _originLocation.start, _originLocation.end,
+			_astID
+		};
+		auto [it, inserted] = m_entries.try_emplace(std::move(key));
+		if (inserted)
+			it->second = DebugData::create(std::move(_nativeLocation), std::move(_originLocation), std::move(_astID));
+		return it->second;
+	}
+
+	/// @returns the number of distinct entries.
+	size_t size() const { return m_entries.size(); }
+
+private:
+	using Key = std::tuple<std::string const*, int, int, std::string const*, int, int, std::optional<int64_t>>;
+	std::map<Key, std::shared_ptr<DebugData const>> m_entries;
+};
+
 struct TypedName { std::shared_ptr<DebugData const> debugData; YulString name; Type type; };
 using TypedNameList = std::vector<TypedName>;
 
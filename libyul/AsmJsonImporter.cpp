@@ -58,7 +58,7 @@ T AsmJsonImporter::createAsmNode(Json::Value const& _node)
 	// TODO: We should add originLocation to the AST.
 	// While it's not included, we'll use nativeLocation for it because we only support importing
 	// inline assembly as a part of a Solidity AST and there these locations are always the same.
-	r.debugData = DebugData::create(nativeLocation, nativeLocation);
+	r.debugData = m_debugDataTable.get(nativeLocation, nativeLocation);
 	return r;
 }
 
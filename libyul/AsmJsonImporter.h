@@ -25,7 +25,7 @@
 
 #include <json/json.h>
 #include <liblangutil/SourceLocation.h>
-#include <libyul/ASTForward.h>
+#include <libyul/AST.h>
 
 #include <utility>
 
@@ -73,6 +73,7 @@ private:
 	yul::Continue createContinue(Json::Value const& _node);
 
 	std::vector<std::shared_ptr<std::string const>> const& m_sourceNames;
+	DebugDataTable m_debugDataTable;
 };
 
 }
@@ -65,11 +65,11 @@ std::shared_ptr<DebugData const> Parser::createDebugData() const
 	switch (m_useSourceLocationFrom)
 	{
 		case UseSourceLocationFrom::Scanner:
-			return DebugData::create(ParserBase::currentLocation(), ParserBase::currentLocation());
+			return m_debugDataTable.get(ParserBase::currentLocation(), ParserBase::currentLocation());
 		case UseSourceLocationFrom::LocationOverride:
-			return DebugData::create(m_locationOverride, m_locationOverride);
+			return m_debugDataOverride;
 		case UseSourceLocationFrom::Comments:
-			return DebugData::create(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
+			return m_debugDataTable.get(ParserBase::currentLocation(), m_locationFromComment, m_astIDFromComment);
 	}
 	solAssert(false, "");
 }
@@ -85,10 +85,11 @@ void Parser::updateLocationEndFrom(
 	{
 		case UseSourceLocationFrom::Scanner:
 		{
-			DebugData updatedDebugData = *_debugData;
-			updatedDebugData.nativeLocation.end = _location.end;
-			updatedDebugData.originLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(std::move(updatedDebugData));
+			SourceLocation nativeLocation = _debugData->nativeLocation;
+			SourceLocation originLocation = _debugData->originLocation;
+			nativeLocation.end = _location.end;
+			originLocation.end = _location.end;
+			_debugData = m_debugDataTable.get(std::move(nativeLocation), std::move(originLocation), _debugData->astID);
 			break;
 		}
 		case UseSourceLocationFrom::LocationOverride:
@@ -96,9 +97,9 @@ void Parser::updateLocationEndFrom(
 			break;
 		case UseSourceLocationFrom::Comments:
 		{
-			DebugData updatedDebugData = *_debugData;
-			updatedDebugData.nativeLocation.end = _location.end;
-			_debugData = make_shared<DebugData const>(std::move(updatedDebugData));
+			SourceLocation nativeLocation = _debugData->nativeLocation;
+			nativeLocation.end = _location.end;
+			_debugData = m_debugDataTable.get(std::move(nativeLocation), _debugData->originLocation, _debugData->astID);
 			break;
 		}
 	}
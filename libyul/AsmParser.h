@@ -61,6 +61,11 @@ public:
 		ParserBase(_errorReporter),
 		m_dialect(_dialect),
 		m_locationOverride{_locationOverride ? *_locationOverride : langutil::SourceLocation{}},
+		m_debugDataOverride{
+			_locationOverride ?
+			DebugData::create(*_locationOverride, *_locationOverride) :
+			nullptr
+		},
 		m_useSourceLocationFrom{
 			_locationOverride ?
 			UseSourceLocationFrom::LocationOverride :
@@ -158,6 +163,10 @@ private:
 
 	std::optional<std::map<unsigned, std::shared_ptr<std::string const>>> m_sourceNames;
 	langutil::SourceLocation m_locationOverride;
+	/// Debug data of all nodes if a location override is used.
+	std::shared_ptr<DebugData const> m_debugDataOverride;
+	/// Debug data of the parsed nodes. One parser is used for the code of each object.
+	mutable DebugDataTable m_debugDataTable;
 	langutil::SourceLocation m_locationFromComment;
 	std::optional<int64_t> m_astIDFromComment;
 	UseSourceLocationFrom m_useSourceLocationFrom = UseSourceLocationFrom::Scanner;
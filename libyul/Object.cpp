@@ -25,6 +25,7 @@
 #include <libyul/AsmJsonConverter.h>
 #include <libyul/AST.h>
 #include <libyul/Exceptions.h>
+#include <libyul/optimiser/ASTCopier.h>
 
 #include <libsolutil/CommonData.h>
 #include <libsolutil/StringUtils.h>
@@ -174,3 +175,23 @@ vector<size_t> Object::pathToSubObject(YulString _qualifiedName) const
 
 	return path;
 }
+
+shared_ptr<Object> Object::clone() const
+{
+	yulAssert(code, "No code");
+
+	auto copy = make_shared<Object>();
+	copy->name = name;
+	copy->subId = subId;
+	copy->code = make_shared<Block>(ASTCopier{}.translate(*code));
+	for (shared_ptr<ObjectNode> const& subNode: subObjects)
+		if (auto const* subObject = dynamic_cast<Object const*>(subNode.get()))
+			copy->subObjects.emplace_back(subObject->clone());
+		else if (auto const* data = dynamic_cast<Data const*>(subNode.get()))
+			copy->subObjects.emplace_back(make_shared<Data>(*data));
+		else
+			yulAssert(false, "");
+	copy->subIndexByName = subIndexByName;
+	copy->debugData = debugData;
+	return copy;
+}
@@ -116,6 +116,10 @@ public:
 	/// The path must not lead to a @a Data object (will throw in that case).
 	std::vector<size_t> pathToSubObject(YulString _qualifiedName) const;
 
+	/// @returns a copy of the object, its code and all its sub-objects that shares no AST nodes
+	/// with the original. The analysis information is not copied.
+	std::shared_ptr<Object> clone() const;
+
 	/// sub id for object if it is subobject of another object, max value if it is not subobject
 	size_t subId = std::numeric_limits<size_t>::max();
 
@@ -0,0 +1,56 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for the optimized code of Yul objects.
+ */
+
+#include <libyul/OptimizedCodeCache.h>
+
+#include <libyul/AST.h>
+#include <libyul/optimiser/ASTCopier.h>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+using namespace solidity::util;
+
+shared_ptr<Block> OptimizedCodeCache::find(h256 const& _key) const
+{
+	shared_ptr<Block const> code;
+	{
+		lock_guard<mutex> lock(m_mutex);
+		auto it = m_code.find(_key);
+		if (it == m_code.end())
+			return nullptr;
+		code = it->second;
+	}
+	return make_shared<Block>(ASTCopier{}.translate(*code));
+}
+
+void OptimizedCodeCache::store(h256 const& _key, Block const& _code)
+{
+	auto code = make_shared<Block const>(ASTCopier{}.translate(_code));
+	lock_guard<mutex> lock(m_mutex);
+	m_code.emplace(_key, std::move(code));
+}
+
+size_t OptimizedCodeCache::size() const
+{
+	lock_guard<mutex> lock(m_mutex);
+	return m_code.size();
+}
@@ -0,0 +1,61 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cache for the optimized code of Yul objects.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+
+#include <libsolutil/FixedHash.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace solidity::yul
+{
+
+/**
+ * Memoizes the result of running the optimiser suite on the code of a Yul object.
+ *
+ * The IR of a contract contains the unoptimized objects of all the contracts it creates, so
+ * without the cache, the code of a contract is optimized once for itself and once more for every
+ * contract that deploys it. Entries are keyed by a hash of everything the result depends on,
+ * i.e. the printed code, the names visible to it and the optimiser settings (see YulStack).
+ *
+ * The cache does not own the YulStrings referenced by the stored code, so it must not outlive
+ * a reset of the YulStringRepository. It can be shared between YulStacks on different threads.
+ */
+class OptimizedCodeCache
+{
+public:
+	/// @returns a copy of the code stored under @a _key or nullptr if there is none.
+	std::shared_ptr<Block> find(util::h256 const& _key) const;
+	/// Stores a copy of @a _code under @a _key.
+	void store(util::h256 const& _key, Block const& _code);
+
+	size_t size() const;
+
+private:
+	mutable std::mutex m_mutex;
+	std::map<util::h256, std::shared_ptr<Block const>> m_code;
+};
+
+}
@@ -24,6 +24,7 @@
 
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
+#include <libyul/AsmPrinter.h>
 #include <libyul/backends/evm/EthAssemblyAdapter.h>
 #include <libyul/backends/evm/EVMCodeTransform.h>
 #include <libyul/backends/evm/EVMDialect.h>
@@ -33,6 +34,8 @@
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/Suite.h>
 #include <libevmasm/Assembly.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/Parallel.h>
 #include <liblangutil/Scanner.h>
 
 #include <boost/algorithm/string.hpp>
@@ -71,6 +74,14 @@ CharStream const& YulStack::charStream(string const& _sourceName) const
 }
 
 bool YulStack::parseAndAnalyze(std::string const& _sourceName, std::string const& _source)
+{
+	if (!parse(_sourceName, _source))
+		return false;
+
+	return analyzeParsed();
+}
+
+shared_ptr<Object> YulStack::parse(string const& _sourceName, string const& _source)
 {
 	m_errors.clear();
 	m_analysisSuccessful = false;
@@ -78,14 +89,25 @@ bool YulStack::parseAndAnalyze(std::string const& _sourceName, std::string const
 	shared_ptr<Scanner> scanner = make_shared<Scanner>(*m_charStream);
 	m_parserResult = ObjectParser(m_errorReporter, languageToDialect(m_language, m_evmVersion)).parse(scanner, false);
 	if (!m_errorReporter.errors().empty())
-		return false;
+		return nullptr;
 	yulAssert(m_parserResult, "");
 	yulAssert(m_parserResult->code, "");
 
+	return m_parserResult;
+}
+
+bool YulStack::analyze(shared_ptr<Object> _object)
+{
+	yulAssert(_object, "");
+	yulAssert(_object->code, "");
+	m_errors.clear();
+	m_charStream.reset();
+	m_parserResult = std::move(_object);
+
 	return analyzeParsed();
 }
 
-void YulStack::optimize()
+void YulStack::optimize(OptimiserProfile* _profile, size_t _jobs)
 {
 	yulAssert(m_analysisSuccessful, "Analysis was not successful.");
 	yulAssert(m_parserResult);
@@ -98,7 +120,10 @@ void YulStack::optimize()
 
 	m_analysisSuccessful = false;
 	yulAssert(m_parserResult, "");
-	optimize(*m_parserResult, true);
+	optional<util::WorkerPool> workers;
+	if (_jobs > 1)
+		workers.emplace(_jobs);
+	optimize(*m_parserResult, true, _profile, workers ? &*workers : nullptr);
 	yulAssert(analyzeParsed(), "Invalid source code after optimization.");
 }
 
@@ -149,7 +174,7 @@ void YulStack::compileEVM(AbstractAssembly& _assembly, bool _optimize) const
 	EVMObjectCompiler::compile(*m_parserResult, _assembly, *dialect, _optimize, m_eofVersion);
 }
 
-void YulStack::optimize(Object& _object, bool _isCreation)
+void YulStack::optimize(Object& _object, bool _isCreation, OptimiserProfile* _profile, util::WorkerPool* _workers)
 {
 	yulAssert(_object.code, "");
 	yulAssert(_object.analysisInfo, "");
@@ -157,10 +182,22 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 		if (auto subObject = dynamic_cast<Object*>(subNode.get()))
 		{
 			bool isCreation = !boost::ends_with(subObject->name.str(), "_deployed");
-			optimize(*subObject, isCreation);
+			optimize(*subObject, isCreation, _profile, _workers);
 		}
 
 	Dialect const& dialect = languageToDialect(m_language, m_evmVersion);
+	optional<util::h256> cacheKey;
+	if (m_optimizedCodeCache)
+	{
+		cacheKey = optimizedCodeCacheKey(_object, _isCreation);
+		if (shared_ptr<Block> cachedCode = m_optimizedCodeCache->find(*cacheKey))
+		{
+			_object.code = std::move(cachedCode);
+			*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(dialect, _object);
+			return;
+		}
+	}
+
 	unique_ptr<GasMeter> meter;
 	if (EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&dialect))
 		meter = make_unique<GasMeter>(*evmDialect, _isCreation, m_optimiserSettings.expectedExecutionsPerDeployment);
@@ -174,8 +211,41 @@ void YulStack::optimize(Object& _object, bool _isCreation)
 		m_optimiserSettings.runYulOptimiser ? m_optimiserSettings.yulOptimiserSteps : "u",
 		m_optimiserSettings.runYulOptimiser ? m_optimiserSettings.yulOptimiserCleanupSteps : "",
 		_isCreation ? nullopt : make_optional(m_optimiserSettings.expectedExecutionsPerDeployment),
-		{}
+		{},
+		_profile,
+		_workers
 	);
+
+	if (cacheKey)
+		m_optimizedCodeCache->store(*cacheKey, *_object.code);
+}
+
+util::h256 YulStack::optimizedCodeCacheKey(Object const& _object, bool _isCreation) const
+{
+	optional<SourceNameMap> sourceNames = _object.debugData ? _object.debugData->sourceNames : nullopt;
+
+	// The printed code includes all debug data, so that the locations in the cached code are
+	// the same as in the code that would have been produced without the cache.
+	string key = AsmPrinter(
+		languageToDialect(m_language, m_evmVersion),
+		sourceNames,
+		DebugInfoSelection::All()
+	)(*_object.code);
+	key += "\n// source names:";
+	if (sourceNames)
+		for (auto const& [index, name]: *sourceNames)
+			key += " " + to_string(index) + ":" + util::toHex(util::asBytes(*name));
+	key += "\n// data names:";
+	for (YulString name: _object.qualifiedDataNames())
+		key += " " + name.str();
+	key += "\n// language: " + to_string(static_cast<int>(m_language));
+	key += "\n// evm version: " + m_evmVersion.name();
+	key += "\n// eof version: " + (m_eofVersion ? to_string(*m_eofVersion) : "none");
+	key += "\n// creation: " + to_string(_isCreation);
+	key += "\n// settings: " + to_string(m_optimiserSettings.runYulOptimiser) + " " + to_string(m_optimiserSettings.optimizeStackAllocation);
+	key += " " + to_string(m_optimiserSettings.expectedExecutionsPerDeployment);
+	key += "\n// steps: " + m_optimiserSettings.yulOptimiserSteps + ":" + m_optimiserSettings.yulOptimiserCleanupSteps;
+	return util::keccak256(key);
 }
 
 MachineAssemblyObject YulStack::assemble(Machine _machine) const
@@ -28,6 +28,7 @@
 
 #include <libyul/Object.h>
 #include <libyul/ObjectParser.h>
+#include <libyul/OptimizedCodeCache.h>
 
 #include <libsolidity/interface/OptimiserSettings.h>
 
@@ -48,9 +49,15 @@ namespace solidity::langutil
 class Scanner;
 }
 
+namespace solidity::util
+{
+class WorkerPool;
+}
+
 namespace solidity::yul
 {
 class AbstractAssembly;
+class OptimiserProfile;
 
 
 struct MachineAssemblyObject
@@ -84,13 +91,15 @@ public:
 		std::optional<uint8_t> _eofVersion,
 		Language _language,
 		solidity::frontend::OptimiserSettings _optimiserSettings,
-		langutil::DebugInfoSelection const& _debugInfoSelection
+		langutil::DebugInfoSelection const& _debugInfoSelection,
+		std::shared_ptr<OptimizedCodeCache> _optimizedCodeCache = nullptr
 	):
 		m_language(_language),
 		m_evmVersion(_evmVersion),
 		m_eofVersion(_eofVersion),
 		m_optimiserSettings(std::move(_optimiserSettings)),
 		m_debugInfoSelection(_debugInfoSelection),
+		m_optimizedCodeCache(std::move(_optimizedCodeCache)),
 		m_errorReporter(m_errors)
 	{}
 
@@ -101,9 +110,24 @@ public:
 	/// Multiple calls overwrite the previous state.
 	bool parseAndAnalyze(std::string const& _sourceName, std::string const& _source);
 
+	/// Runs the parsing step only, so that the result can be combined with other objects
+	/// before it is passed to @a analyze.
+	/// @returns the parsed object or nullptr if the input cannot be parsed.
+	std::shared_ptr<Object> parse(std::string const& _sourceName, std::string const& _source);
+
+	/// Runs the analysis step on @a _object, which was not necessarily parsed by this stack,
+	/// and makes it the result of the stack. Returns false if the object cannot be assembled.
+	/// Multiple calls overwrite the previous state.
+	bool analyze(std::shared_ptr<Object> _object);
+
 	/// Run the optimizer suite. Can only be used with Yul or strict assembly.
 	/// If the settings (see constructor) disabled the optimizer, nothing is done here.
-	void optimize();
+	/// If a cache was passed to the constructor, the optimized code of objects already found in it
+	/// is reused and the code of all other objects is added to it.
+	/// If @a _profile is given, the cost of the optimiser steps is recorded there.
+	/// Steps that transform each function on its own use up to @a _jobs threads, which are kept
+	/// for all steps and objects.
+	void optimize(OptimiserProfile* _profile = nullptr, size_t _jobs = 1);
 
 	/// Run the assembly step (should only be called after parseAndAnalyze).
 	MachineAssemblyObject assemble(Machine _machine) const;
@@ -142,13 +166,16 @@ private:
 
 	void compileEVM(yul::AbstractAssembly& _assembly, bool _optimize) const;
 
-	void optimize(yul::Object& _object, bool _isCreation);
+	void optimize(yul::Object& _object, bool _isCreation, OptimiserProfile* _profile, util::WorkerPool* _workers);
+	/// @returns the key under which the optimized code of @a _object is stored in the cache.
+	util::h256 optimizedCodeCacheKey(yul::Object const& _object, bool _isCreation) const;
 
 	Language m_language = Language::Assembly;
 	langutil::EVMVersion m_evmVersion;
 	std::optional<uint8_t> m_eofVersion;
 	solidity::frontend::OptimiserSettings m_optimiserSettings;
 	langutil::DebugInfoSelection m_debugInfoSelection{};
+	std::shared_ptr<OptimizedCodeCache> m_optimizedCodeCache;
 
 	std::unique_ptr<langutil::CharStream> m_charStream;
 
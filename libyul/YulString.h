@@ -23,25 +23,37 @@
 
 #include <fmt/format.h>
 
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
 #include <unordered_map>
-#include <memory>
 #include <vector>
-#include <string>
-#include <functional>
 
 namespace solidity::yul
 {
 
 /// Repository for YulStrings.
 /// Owns the string data for all YulStrings, which can be referenced by a Handle.
-/// A Handle consists of an ID (that depends on the insertion order of YulStrings and is potentially
-/// non-deterministic) and a deterministic string hash.
+/// A Handle consists of a pointer to the interned string (whose address depends on the insertion
+/// order and is potentially non-deterministic) and a deterministic string hash.
+/// The deterministic hash defines the order of YulStrings and is only computed when a string is
+/// interned for the first time. Lookups use the faster lookupHash instead.
+/// The repository is split into shards selected by the lookupHash, each guarded by its own mutex,
+/// so that several threads can intern strings concurrently with little contention.
+/// Recently interned strings are additionally kept in a small per-thread cache that is
+/// consulted before taking any lock.
+/// Interned strings are never moved, so reading the string of a Handle does not need any locking.
 class YulStringRepository
 {
 public:
 	struct Handle
 	{
-		size_t id;
+		/// Interned string, nullptr for the empty string.
+		std::string const* string;
 		std::uint64_t hash;
 	};
 
@@ -54,23 +66,30 @@ public:
 	Handle stringToHandle(std::string const& _string)
 	{
 		if (_string.empty())
-			return { 0, emptyHash() };
-		std::uint64_t h = hash(_string);
-		auto range = m_hashToID.equal_range(h);
+			return { nullptr, emptyHash() };
+		std::uint64_t lookup = lookupHash(_string);
+		Handle& cached = cachedHandle(lookup);
+		if (cached.string && *cached.string == _string)
+			return cached;
+
+		Shard& shard = m_shards[shardIndex(lookup)];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		auto range = shard.handles.equal_range(lookup);
 		for (auto it = range.first; it != range.second; ++it)
-			if (*m_strings[it->second] == _string)
-				return Handle{it->second, h};
-		m_strings.emplace_back(std::make_shared<std::string>(_string));
-		size_t id = m_strings.size() - 1;
-		m_hashToID.emplace_hint(range.second, std::make_pair(h, id));
+			if (*it->second.string == _string)
+				return cached = it->second;
+		Handle handle{&shard.strings.emplace_back(_string), hash(_string)};
+		shard.handles.emplace_hint(range.second, std::make_pair(lookup, handle));
 
-		return Handle{id, h};
+		return cached = handle;
 	}
-	std::string const& idToString(size_t _id) const	{ return *m_strings.at(_id); }
 
+	/// Deterministic hash that defines the order of YulStrings.
+	/// Changing it changes the iteration order of containers of YulStrings
+	/// and thus the output of the optimiser.
 	static std::uint64_t hash(std::string const& v)
 	{
-		// FNV hash - can be replaced by a better one, e.g. xxhash64
+		// FNV hash
 		std::uint64_t hash = emptyHash();
 		for (char c: v)
 		{
@@ -81,15 +100,73 @@ public:
 		return hash;
 	}
 	static constexpr std::uint64_t emptyHash() { return 14695981039346656037u; }
+	/// Hash used to find already interned strings. This is XXH64 with seed zero,
+	/// reading whole words at a time and using four independent lanes for long strings.
+	/// The value depends on the endianness of the platform and must not be used
+	/// for anything that influences the output.
+	static std::uint64_t lookupHash(std::string const& _string)
+	{
+		constexpr std::uint64_t prime1 = 11400714785074694791u;
+		constexpr std::uint64_t prime2 = 14029467366897019727u;
+		constexpr std::uint64_t prime3 = 1609587929392839161u;
+		constexpr std::uint64_t prime4 = 9650029242287828579u;
+		constexpr std::uint64_t prime5 = 2870177450012600261u;
+		auto rotl = [](std::uint64_t _x, int _bits) { return (_x << _bits) | (_x >> (64 - _bits)); };
+		auto round = [&](std::uint64_t _acc, std::uint64_t _input) { return rotl(_acc + _input * prime2, 31) * prime1; };
+		auto merge = [&](std::uint64_t _acc, std::uint64_t _lane) { return (_acc ^ round(0, _lane)) * prime1 + prime4; };
+		auto read64 = [](char const* _p) { std::uint64_t v; std::memcpy(&v, _p, 8); return v; };
+		auto read32 = [](char const* _p) { std::uint32_t v; std::memcpy(&v, _p, 4); return v; };
+
+		char const* p = _string.data();
+		char const* const end = p + _string.size();
+		std::uint64_t h;
+		if (_string.size() >= 32)
+		{
+			std::uint64_t lanes[4] = {prime1 + prime2, prime2, 0, 0 - prime1};
+			for (; p + 32 <= end; p += 32)
+				for (size_t i = 0; i < 4; ++i)
+					lanes[i] = round(lanes[i], read64(p + 8 * i));
+			h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+			for (std::uint64_t lane: lanes)
+				h = merge(h, lane);
+		}
+		else
+			h = prime5;
+		h += static_cast<std::uint64_t>(_string.size());
+		for (; p + 8 <= end; p += 8)
+			h = rotl(h ^ round(0, read64(p)), 27) * prime1 + prime4;
+		if (p + 4 <= end)
+		{
+			h = rotl(h ^ (static_cast<std::uint64_t>(read32(p)) * prime1), 23) * prime2 + prime3;
+			p += 4;
+		}
+		for (; p < end; ++p)
+			h = rotl(h ^ (static_cast<std::uint64_t>(static_cast<unsigned char>(*p)) * prime5), 11) * prime1;
+		h ^= h >> 33;
+		h *= prime2;
+		h ^= h >> 29;
+		h *= prime3;
+		h ^= h >> 32;
+		return h;
+	}
+	static std::string const& emptyString()
+	{
+		static std::string const empty;
+		return empty;
+	}
 	/// Clear the repository.
-	/// Use with care - there cannot be any dangling YulString references.
+	/// Use with care - there cannot be any dangling YulString references
+	/// and no other thread may be using YulStrings at the same time.
 	/// If references need to be cleared manually, register the callback via
 	/// resetCallback.
 	static void reset()
 	{
-		for (auto const& cb: resetCallbacks())
-			cb();
-		instance() = YulStringRepository{};
+		{
+			std::lock_guard<std::mutex> lock(resetCallbacksMutex());
+			for (auto const& cb: resetCallbacks())
+				cb();
+		}
+		instance().clear();
 	}
 	/// Struct that registers a reset callback as a side-effect of its construction.
 	/// Useful as static local variable to register a reset callback once.
@@ -97,29 +174,81 @@ public:
 	{
 		ResetCallback(std::function<void()> _fun)
 		{
+			std::lock_guard<std::mutex> lock(resetCallbacksMutex());
 			YulStringRepository::resetCallbacks().emplace_back(std::move(_fun));
 		}
 	};
 
 private:
+	static constexpr size_t shardBits = 4;
+
+	struct Shard
+	{
+		std::mutex mutex;
+		/// Deque, so that references to the strings stay valid when new ones are added.
+		std::deque<std::string> strings;
+		/// Handles of the interned strings by their lookup hash.
+		std::unordered_multimap<std::uint64_t, Handle> handles;
+	};
+
 	YulStringRepository() = default;
 	YulStringRepository(YulStringRepository const&) = delete;
-	YulStringRepository(YulStringRepository&&) = default;
 	YulStringRepository& operator=(YulStringRepository const& _rhs) = delete;
-	YulStringRepository& operator=(YulStringRepository&& _rhs) = default;
+
+	/// Direct-mapped cache of handles, only valid as long as its generation
+	/// matches the one of the repository.
+	struct ThreadCache
+	{
+		size_t generation = 0;
+		std::array<Handle, 1024> entries{};
+	};
+
+	/// @returns the shard for the given lookupHash (XXH64), not the deterministic hash().
+	/// Uses its upper bits, the lower ones select the bucket inside the shard.
+	static size_t shardIndex(std::uint64_t _lookupHash) { return static_cast<size_t>(_lookupHash >> (64 - shardBits)); }
+
+	/// @returns the slot of the per-thread cache for the given lookup hash.
+	Handle& cachedHandle(std::uint64_t _lookupHash)
+	{
+		thread_local ThreadCache cache;
+		size_t generation = m_generation.load(std::memory_order_acquire);
+		if (cache.generation != generation)
+		{
+			cache.entries.fill(Handle{nullptr, 0});
+			cache.generation = generation;
+		}
+		return cache.entries[static_cast<size_t>(_lookupHash) % cache.entries.size()];
+	}
+
+	void clear()
+	{
+		for (Shard& shard: m_shards)
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.handles.clear();
+			shard.strings.clear();
+		}
+		// Invalidates the per-thread caches.
+		m_generation.fetch_add(1, std::memory_order_release);
+	}
 
 	static std::vector<std::function<void()>>& resetCallbacks()
 	{
 		static std::vector<std::function<void()>> callbacks;
 		return callbacks;
 	}
+	static std::mutex& resetCallbacksMutex()
+	{
+		static std::mutex mutex;
+		return mutex;
+	}
 
-	std::vector<std::shared_ptr<std::string>> m_strings = {std::make_shared<std::string>()};
-	std::unordered_multimap<std::uint64_t, size_t> m_hashToID = {{emptyHash(), 0}};
+	std::array<Shard, size_t(1) << shardBits> m_shards;
+	std::atomic<size_t> m_generation = 0;
 };
 
 /// Wrapper around handles into the YulString repository.
-/// Equality of two YulStrings is determined by comparing their ID.
+/// Equality of two YulStrings is determined by comparing the addresses of the interned strings.
 /// The <-operator depends on the string hash and is not consistent
 /// with string comparisons (however, it is still deterministic).
 class YulString
@@ -134,32 +263,32 @@ public:
 
 	/// This is not consistent with the string <-operator!
 	/// First compares the string hashes. If they are equal
-	/// it checks for identical IDs (only identical strings have
-	/// identical IDs and identical strings do not compare as "less").
+	/// it checks for identical handles (only identical strings have
+	/// identical handles and identical strings do not compare as "less").
 	/// If the hashes are identical and the strings are distinct, it
 	/// falls back to string comparison.
 	bool operator<(YulString const& _other) const
 	{
 		if (m_handle.hash < _other.m_handle.hash) return true;
 		if (_other.m_handle.hash < m_handle.hash) return false;
-		if (m_handle.id == _other.m_handle.id) return false;
+		if (m_handle.string == _other.m_handle.string) return false;
 		return str() < _other.str();
 	}
-	/// Equality is determined based on the string ID.
-	bool operator==(YulString const& _other) const { return m_handle.id == _other.m_handle.id; }
-	bool operator!=(YulString const& _other) const { return m_handle.id != _other.m_handle.id; }
+	/// Equality is determined based on the interned string.
+	bool operator==(YulString const& _other) const { return m_handle.string == _other.m_handle.string; }
+	bool operator!=(YulString const& _other) const { return m_handle.string != _other.m_handle.string; }
 
-	bool empty() const { return m_handle.id == 0; }
+	bool empty() const { return !m_handle.string; }
 	std::string const& str() const
 	{
-		return YulStringRepository::instance().idToString(m_handle.id);
+		return m_handle.string ? *m_handle.string : YulStringRepository::emptyString();
 	}
 
 	uint64_t hash() const { return m_handle.hash; }
 
 private:
-	/// Handle of the string. Assumes that the empty string has ID zero.
-	YulStringRepository::Handle m_handle{ 0, YulStringRepository::emptyHash() };
+	/// Handle of the string. The empty string is represented by a null string pointer.
+	YulStringRepository::Handle m_handle{ nullptr, YulStringRepository::emptyHash() };
 };
 
 inline YulString operator "" _yulstring(char const* _string, std::size_t _size)
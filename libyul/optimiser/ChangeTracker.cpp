@@ -0,0 +1,307 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/ChangeTracker.h>
+
+#include <libyul/optimiser/BlockHasher.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/AST.h>
+#include <libyul/ControlFlowSideEffects.h>
+#include <libyul/SideEffects.h>
+
+#include <libsolutil/CommonData.h>
+
+#include <range/v3/view/map.hpp>
+
+#include <functional>
+#include <set>
+#include <string>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+/**
+ * Hashes the syntax, names and debug data of the visited nodes. In contrast to the BlockHasher,
+ * names are taken into account and nodes with different debug data have different hashes,
+ * so that equal hashes mean (up to collisions) identical code.
+ */
+class FingerprintHasher: public ASTWalker, public HasherBase
+{
+public:
+	using ASTWalker::operator();
+
+	uint64_t hash() const { return m_hash; }
+
+	void operator()(Literal const& _literal) override
+	{
+		hashDebugData(_literal.debugData.get());
+		hash8(static_cast<uint8_t>(_literal.kind));
+		hash64(_literal.value.hash());
+		hash64(_literal.type.hash());
+	}
+	void operator()(Identifier const& _identifier) override
+	{
+		hashDebugData(_identifier.debugData.get());
+		hash64(_identifier.name.hash());
+	}
+	void operator()(FunctionCall const& _funCall) override
+	{
+		hashDebugData(_funCall.debugData.get());
+		(*this)(_funCall.functionName);
+		hash64(_funCall.arguments.size());
+		ASTWalker::operator()(_funCall);
+	}
+	void operator()(Assignment const& _assignment) override
+	{
+		hash64(_assignment.variableNames.size());
+		ASTWalker::operator()(_assignment);
+	}
+	void operator()(VariableDeclaration const& _varDecl) override
+	{
+		hashTypedNames(_varDecl.variables);
+		hash8(_varDecl.value ? 1 : 0);
+		ASTWalker::operator()(_varDecl);
+	}
+	void operator()(Switch const& _switch) override
+	{
+		hash64(_switch.cases.size());
+		for (Case const& _case: _switch.cases)
+		{
+			hashDebugData(_case.debugData.get());
+			hash8(_case.value ? 1 : 0);
+		}
+		ASTWalker::operator()(_switch);
+	}
+	void operator()(FunctionDefinition const& _function) override
+	{
+		hash64(_function.name.hash());
+		hashTypedNames(_function.parameters);
+		hashTypedNames(_function.returnVariables);
+		ASTWalker::operator()(_function);
+	}
+	void operator()(Block const& _block) override
+	{
+		hashDebugData(_block.debugData.get());
+		hash64(_block.statements.size());
+		ASTWalker::operator()(_block);
+	}
+
+	void visit(Statement const& _statement) override
+	{
+		hash8(static_cast<uint8_t>(_statement.index()));
+		hashDebugData(std::visit([](auto const& _node) { return _node.debugData.get(); }, _statement));
+		ASTWalker::visit(_statement);
+	}
+	void visit(Expression const& _expression) override
+	{
+		hash8(static_cast<uint8_t>(_expression.index()));
+		ASTWalker::visit(_expression);
+	}
+
+	void hashName(YulString _name) { hash64(_name.hash()); }
+
+private:
+	void hashDebugData(DebugData const* _debugData)
+	{
+		// Debug data is shared between nodes and replaced by copies, so its content is hashed
+		// rather than its address.
+		hash8(_debugData ? 1 : 0);
+		if (!_debugData)
+			return;
+		hashLocation(_debugData->nativeLocation);
+		hashLocation(_debugData->originLocation);
+		hash8(_debugData->astID ? 1 : 0);
+		if (_debugData->astID)
+			hash64(static_cast<uint64_t>(*_debugData->astID));
+	}
+	void hashLocation(langutil::SourceLocation const& _location)
+	{
+		hash8(_location.sourceName ? 1 : 0);
+		if (_location.sourceName)
+			hash64(std::hash<string>{}(*_location.sourceName));
+		hash64(static_cast<uint64_t>(_location.start));
+		hash64(static_cast<uint64_t>(_location.end));
+	}
+	void hashTypedNames(TypedNameList const& _names)
+	{
+		hash64(_names.size());
+		for (TypedName const& name: _names)
+		{
+			hashDebugData(name.debugData.get());
+			hash64(name.name.hash());
+			hash64(name.type.hash());
+		}
+	}
+};
+
+}
+
+bool ChangeTracker::update(Block const& _ast)
+{
+	bool const initialUpdate = !m_initialized;
+	m_initialized = true;
+	bool changed = initialUpdate;
+
+	// The order of all statements and the top-level code, including code in nested blocks, is
+	// part of the fingerprint of the code. Functions are fingerprinted individually.
+	FingerprintHasher codeHasher;
+	size_t functionCount = 0;
+	for (Statement const& statement: _ast.statements)
+		if (FunctionDefinition const* function = get_if<FunctionDefinition>(&statement))
+		{
+			++functionCount;
+			codeHasher.hashName(function->name);
+
+			FingerprintHasher functionHasher;
+			functionHasher(*function);
+			auto&& [it, inserted] = m_functions.try_emplace(function->name);
+			Fingerprint& fingerprint = it->second;
+			if (inserted || fingerprint.hash != functionHasher.hash())
+			{
+				fingerprint.hash = functionHasher.hash();
+				fingerprint.codeSize =
+					CodeWeights{}.functionDefinitionCost +
+					CodeSize::codeSizeIncludingFunctions(function->body);
+				// The version is increased below.
+				fingerprint.version = m_version + 1;
+				changed = true;
+			}
+		}
+		else
+			codeHasher.visit(statement);
+
+	if (functionCount != m_functions.size())
+	{
+		set<YulString> functionNames;
+		for (Statement const& statement: _ast.statements)
+			if (FunctionDefinition const* function = get_if<FunctionDefinition>(&statement))
+				functionNames.insert(function->name);
+		for (auto it = m_functions.begin(); it != m_functions.end();)
+			if (functionNames.count(it->first))
+				++it;
+			else
+				it = m_functions.erase(it);
+		changed = true;
+	}
+
+	if (initialUpdate || m_code.hash != codeHasher.hash())
+	{
+		m_code.hash = codeHasher.hash();
+		m_code.codeSize = 0;
+		for (Statement const& statement: _ast.statements)
+			if (!holds_alternative<FunctionDefinition>(statement))
+				m_code.codeSize += CodeSize::codeSizeIncludingFunctions(statement);
+		m_code.version = m_version + 1;
+		changed = true;
+	}
+
+	if (changed)
+		++m_version;
+	return changed;
+}
+
+optional<size_t> ChangeTracker::partVersion(YulString _function) const
+{
+	if (_function.empty())
+		return m_initialized ? make_optional(m_code.version) : nullopt;
+	if (Fingerprint const* fingerprint = util::valueOrNullptr(m_functions, _function))
+		return fingerprint->version;
+	return nullopt;
+}
+
+size_t ChangeTracker::codeSize() const
+{
+	size_t size = m_code.codeSize;
+	for (auto const& function: m_functions | ranges::views::values)
+		size += function.codeSize;
+	return size;
+}
+
+bool UnchangedParts::skip(YulString _part, uint64_t _dependencies)
+{
+	optional<size_t> version = m_tracker.partVersion(_part);
+	if (version)
+		if (auto const* unchanged = util::valueOrNullptr(m_unchanged, _part))
+			if (*unchanged == make_pair(*version, _dependencies))
+				return true;
+	m_transformed.emplace_back(_part, version, _dependencies);
+	return false;
+}
+
+void UnchangedParts::update()
+{
+	for (auto const& [part, version, dependencies]: m_transformed)
+		if (version && m_tracker.partVersion(part) == version)
+			m_unchanged[part] = {*version, dependencies};
+		else
+			m_unchanged.erase(part);
+	m_transformed.clear();
+}
+
+DependencyHasher& DependencyHasher::operator()(map<YulString, SideEffects> const& _sideEffects)
+{
+	hash64(_sideEffects.size());
+	for (auto const& [name, sideEffects]: _sideEffects)
+	{
+		hash64(name.hash());
+		hash8(static_cast<uint8_t>(
+			(sideEffects.movable ? 1 : 0) |
+			(sideEffects.movableApartFromEffects ? 2 : 0) |
+			(sideEffects.canBeRemoved ? 4 : 0) |
+			(sideEffects.canBeRemovedIfNoMSize ? 8 : 0) |
+			(sideEffects.cannotLoop ? 16 : 0)
+		));
+		hash8(static_cast<uint8_t>(sideEffects.otherState));
+		hash8(static_cast<uint8_t>(sideEffects.storage));
+		hash8(static_cast<uint8_t>(sideEffects.memory));
+	}
+	return *this;
+}
+
+DependencyHasher& DependencyHasher::operator()(map<YulString, ControlFlowSideEffects> const& _sideEffects)
+{
+	hash64(_sideEffects.size());
+	for (auto const& [name, sideEffects]: _sideEffects)
+	{
+		hash64(name.hash());
+		hash8(static_cast<uint8_t>(
+			(sideEffects.canTerminate ? 1 : 0) |
+			(sideEffects.canRevert ? 2 : 0) |
+			(sideEffects.canContinue ? 4 : 0)
+		));
+	}
+	return *this;
+}
+
+DependencyHasher& DependencyHasher::operator()(optional<size_t> _value)
+{
+	hash8(_value ? 1 : 0);
+	if (_value)
+		hash64(*_value);
+	return *this;
+}
+
+DependencyHasher& DependencyHasher::operator()(bool _value)
+{
+	hash8(_value ? 1 : 0);
+	return *this;
+}
@@ -0,0 +1,129 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Detection of changes to the functions of a Yul AST between optimiser steps.
+ */
+
+#pragma once
+
+#include <libyul/optimiser/BlockHasher.h>
+
+#include <libyul/ASTForward.h>
+#include <libyul/YulString.h>
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+namespace solidity::yul
+{
+
+struct SideEffects;
+struct ControlFlowSideEffects;
+
+/**
+ * Keeps a fingerprint and the code size of every top-level function of an AST and of the
+ * remaining top-level code, and detects which of them changed since the last update.
+ *
+ * Every update that finds a change starts a new version of the AST. Optimiser steps are
+ * deterministic, so a step that did not change the AST in some version will not change it
+ * when it is applied to the same version again.
+ *
+ * The fingerprint is a hash of the syntax, the names and the debug data, so changes are
+ * detected up to hash collisions. Code sizes are only recomputed for the changed parts.
+ */
+class ChangeTracker
+{
+public:
+	/// Compares @a _ast with the state at the last update.
+	/// @returns true if anything changed, in which case a new version is started.
+	bool update(Block const& _ast);
+
+	/// @returns the version of the AST at the last update.
+	size_t version() const { return m_version; }
+	/// @returns the version in which the function @a _function last changed, or the remaining
+	/// top-level code if @a _function is empty. Returns nullopt if there is no such function.
+	std::optional<size_t> partVersion(YulString _function) const;
+	/// @returns the code size of the AST at the last update, equal to
+	/// CodeSize::codeSizeIncludingFunctions.
+	size_t codeSize() const;
+
+private:
+	struct Fingerprint
+	{
+		uint64_t hash = 0;
+		size_t codeSize = 0;
+		/// Version in which the part last changed.
+		size_t version = 0;
+	};
+
+	/// Top-level statements that are not function definitions and the order of all statements.
+	Fingerprint m_code;
+	std::map<YulString, Fingerprint> m_functions;
+	size_t m_version = 0;
+	bool m_initialized = false;
+};
+
+/**
+ * Parts of a function-grouped AST, i.e. its top-level code and each of its functions, that an
+ * optimiser step transformed without changing them. Parts are identified by the function name,
+ * the top-level code by the empty name.
+ *
+ * Transforming a part again can be skipped as long as neither the part nor the dependencies
+ * of the step changed. The dependencies are a hash of all information about the rest of the
+ * AST that the step uses to transform a part, see DependencyHasher.
+ */
+class UnchangedParts
+{
+public:
+	explicit UnchangedParts(ChangeTracker const& _tracker): m_tracker(_tracker) {}
+
+	/// @returns true if transforming @a _part can be skipped. Otherwise, the part is expected
+	/// to be transformed and it is checked for changes in the next call to update().
+	/// The change tracker has to be up to date with the AST.
+	bool skip(YulString _part, uint64_t _dependencies);
+	/// Records which of the parts transformed since the last call were not changed.
+	/// Has to be called after the change tracker was updated with the transformed AST.
+	void update();
+
+private:
+	ChangeTracker const& m_tracker;
+	/// Version of the part and dependencies for each part that was transformed without change.
+	std::map<YulString, std::pair<size_t, uint64_t>> m_unchanged;
+	/// Parts that were transformed since the last update, with their version and dependencies.
+	std::vector<std::tuple<YulString, std::optional<size_t>, uint64_t>> m_transformed;
+};
+
+/**
+ * Hashes the information about the rest of the AST that an optimiser step uses to transform
+ * a single function, e.g. the side effects of all functions.
+ */
+class DependencyHasher: public HasherBase
+{
+public:
+	DependencyHasher& operator()(std::map<YulString, SideEffects> const& _sideEffects);
+	DependencyHasher& operator()(std::map<YulString, ControlFlowSideEffects> const& _sideEffects);
+	DependencyHasher& operator()(std::optional<size_t> _value);
+	DependencyHasher& operator()(bool _value);
+
+	uint64_t hash() const { return m_hash; }
+};
+
+}
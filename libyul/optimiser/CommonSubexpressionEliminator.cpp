@@ -24,6 +24,8 @@
 #include <libyul/optimiser/SyntacticalEquality.h>
 #include <libyul/optimiser/BlockHasher.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/ChangeTracker.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/SideEffects.h>
 #include <libyul/Exceptions.h>
@@ -38,11 +40,19 @@ using namespace solidity::util;
 
 void CommonSubexpressionEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	CommonSubexpressionEliminator cse{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast))
-	};
-	cse(_ast);
+	map<YulString, SideEffects> functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	transformFunctions(
+		_context,
+		_ast,
+		[&]() -> function<void(Block&)> {
+			shared_ptr<CommonSubexpressionEliminator> cse{
+				new CommonSubexpressionEliminator{_context.dialect, functionSideEffects}
+			};
+			return [cse](Block& _part) { (*cse)(_part); };
+		},
+		DependencyHasher{}(functionSideEffects).hash()
+	);
 }
 
 CommonSubexpressionEliminator::CommonSubexpressionEliminator(
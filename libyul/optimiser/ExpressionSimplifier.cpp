@@ -35,7 +35,10 @@ using namespace solidity::yul;
 
 void ExpressionSimplifier::run(OptimiserStepContext& _context, Block& _ast)
 {
-	ExpressionSimplifier{_context.dialect}(_ast);
+	transformFunctions(_context, _ast, [&]() -> function<void(Block&)> {
+		shared_ptr<ExpressionSimplifier> simplifier{new ExpressionSimplifier{_context.dialect}};
+		return [simplifier](Block& _part) { (*simplifier)(_part); };
+	});
 }
 
 void ExpressionSimplifier::visit(Expression& _expression)
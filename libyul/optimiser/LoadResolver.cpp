@@ -24,6 +24,7 @@
 
 #include <libyul/backends/evm/EVMDialect.h>
 #include <libyul/backends/evm/EVMMetrics.h>
+#include <libyul/optimiser/ChangeTracker.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/CallGraphGenerator.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
@@ -45,12 +46,22 @@ using namespace solidity::yul;
 void LoadResolver::run(OptimiserStepContext& _context, Block& _ast)
 {
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
-	LoadResolver{
-		_context.dialect,
-		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast)),
-		containsMSize,
-		_context.expectedExecutionsPerDeployment
-	}(_ast);
+	map<YulString, SideEffects> functionSideEffects =
+		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
+	transformFunctions(
+		_context,
+		_ast,
+		[&]() -> function<void(Block&)> {
+			shared_ptr<LoadResolver> loadResolver{new LoadResolver{
+				_context.dialect,
+				functionSideEffects,
+				containsMSize,
+				_context.expectedExecutionsPerDeployment
+			}};
+			return [loadResolver](Block& _part) { (*loadResolver)(_part); };
+		},
+		DependencyHasher{}(functionSideEffects)(containsMSize)(_context.expectedExecutionsPerDeployment).hash()
+	);
 }
 
 void LoadResolver::visit(Expression& _e)
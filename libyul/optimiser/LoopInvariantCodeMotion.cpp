@@ -19,7 +19,9 @@
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 
 #include <libyul/optimiser/CallGraphGenerator.h>
+#include <libyul/optimiser/ChangeTracker.h>
 #include <libyul/optimiser/NameCollector.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/SSAValueTracker.h>
 #include <libyul/AST.h>
@@ -37,7 +39,18 @@ void LoopInvariantCodeMotion::run(OptimiserStepContext& _context, Block& _ast)
 		SideEffectsPropagator::sideEffects(_context.dialect, CallGraphGenerator::callGraph(_ast));
 	bool containsMSize = MSizeFinder::containsMSize(_context.dialect, _ast);
 	set<YulString> ssaVars = SSAValueTracker::ssaVariables(_ast);
-	LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_ast);
+	// Variables are only assigned in the function that declares them, so whether the variables
+	// of a part are SSA variables only depends on the part itself.
+	transformFunctions(
+		_context,
+		_ast,
+		[&]() -> function<void(Block&)> {
+			return [&](Block& _part) {
+				LoopInvariantCodeMotion{_context.dialect, ssaVars, functionSideEffects, containsMSize}(_part);
+			};
+		},
+		DependencyHasher{}(functionSideEffects)(containsMSize).hash()
+	);
 }
 
 void LoopInvariantCodeMotion::operator()(Block& _block)
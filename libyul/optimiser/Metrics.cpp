@@ -103,6 +103,13 @@ size_t CodeSize::codeSize(Block const& _block, CodeWeights const& _weights)
 	return cs.m_size;
 }
 
+size_t CodeSize::codeSizeIncludingFunctions(Statement const& _statement, CodeWeights const& _weights)
+{
+	CodeSize cs(false, _weights);
+	cs.visit(_statement);
+	return cs.m_size;
+}
+
 size_t CodeSize::codeSizeIncludingFunctions(Block const& _block, CodeWeights const& _weights)
 {
 	CodeSize cs(false, _weights);
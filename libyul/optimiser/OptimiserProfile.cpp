@@ -0,0 +1,113 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libyul/optimiser/OptimiserProfile.h>
+
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/AST.h>
+
+using namespace std;
+using namespace std::chrono;
+using namespace solidity;
+using namespace solidity::yul;
+
+namespace
+{
+
+Json::Value toMicroseconds(steady_clock::duration _duration)
+{
+	return Json::Int64(duration_cast<microseconds>(_duration).count());
+}
+
+}
+
+void OptimiserProfile::record(
+	string const& _step,
+	steady_clock::duration _duration,
+	size_t _nodesBefore,
+	size_t _nodesAfter
+)
+{
+	StepMetrics& metrics = m_steps[_step];
+	++metrics.invocations;
+	metrics.duration += _duration;
+	metrics.nodesBefore += _nodesBefore;
+	metrics.nodesAfter += _nodesAfter;
+}
+
+void OptimiserProfile::merge(OptimiserProfile const& _other)
+{
+	for (auto const& [step, otherMetrics]: _other.m_steps)
+	{
+		StepMetrics& metrics = m_steps[step];
+		metrics.invocations += otherMetrics.invocations;
+		metrics.duration += otherMetrics.duration;
+		metrics.nodesBefore += otherMetrics.nodesBefore;
+		metrics.nodesAfter += otherMetrics.nodesAfter;
+	}
+}
+
+steady_clock::duration OptimiserProfile::totalDuration() const
+{
+	steady_clock::duration total{0};
+	for (auto const& metrics: m_steps)
+		total += metrics.second.duration;
+	return total;
+}
+
+Json::Value OptimiserProfile::toJson() const
+{
+	Json::Value steps(Json::objectValue);
+	for (auto const& [step, metrics]: m_steps)
+	{
+		Json::Value& stepJson = steps[step];
+		stepJson["invocations"] = Json::UInt64(metrics.invocations);
+		stepJson["durationMicroseconds"] = toMicroseconds(metrics.duration);
+		stepJson["nodesBefore"] = Json::UInt64(metrics.nodesBefore);
+		stepJson["nodesAfter"] = Json::UInt64(metrics.nodesAfter);
+	}
+
+	Json::Value profile(Json::objectValue);
+	profile["steps"] = std::move(steps);
+	profile["totalDurationMicroseconds"] = toMicroseconds(totalDuration());
+	return profile;
+}
+
+size_t OptimiserProfile::countNodes(Block const& _block)
+{
+	// Every statement and expression counts as one node, except for blocks, which only group
+	// other statements.
+	CodeWeights weights;
+	weights.expressionStatementCost = 1;
+	weights.assignmentCost = 1;
+	weights.variableDeclarationCost = 1;
+	weights.functionDefinitionCost = 1;
+	weights.ifCost = 1;
+	weights.switchCost = 1;
+	weights.caseCost = 1;
+	weights.forLoopCost = 1;
+	weights.breakCost = 1;
+	weights.continueCost = 1;
+	weights.leaveCost = 1;
+	weights.blockCost = 0;
+	weights.functionCallCost = 1;
+	weights.identifierCost = 1;
+	weights.literalCost = 1;
+	weights.literalZeroCost = 1;
+	return CodeSize::codeSizeIncludingFunctions(_block, weights);
+}
@@ -0,0 +1,78 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Cost of the steps run by the Yul optimiser suite.
+ */
+
+#pragma once
+
+#include <libyul/ASTForward.h>
+
+#include <json/json.h>
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace solidity::yul
+{
+
+/**
+ * Collects the wall time, number of invocations and number of AST nodes before and after
+ * each step of the optimiser suite. Can be passed to OptimiserSuite::run to profile the
+ * optimisation of an object.
+ * Not thread-safe: each concurrent optimisation needs its own profile.
+ */
+class OptimiserProfile
+{
+public:
+	struct StepMetrics
+	{
+		size_t invocations = 0;
+		std::chrono::steady_clock::duration duration{0};
+		/// Sum of the number of AST nodes before each invocation of the step.
+		size_t nodesBefore = 0;
+		/// Sum of the number of AST nodes after each invocation of the step.
+		size_t nodesAfter = 0;
+	};
+
+	void record(
+		std::string const& _step,
+		std::chrono::steady_clock::duration _duration,
+		size_t _nodesBefore,
+		size_t _nodesAfter
+	);
+	/// Adds the metrics collected in @a _other to this profile.
+	void merge(OptimiserProfile const& _other);
+
+	std::map<std::string, StepMetrics> const& steps() const { return m_steps; }
+	std::chrono::steady_clock::duration totalDuration() const;
+
+	/// @returns the profile as {"steps": {<name>: {"invocations", "durationMicroseconds",
+	/// "nodesBefore", "nodesAfter"}}, "totalDurationMicroseconds"}.
+	Json::Value toJson() const;
+
+	/// @returns the number of AST nodes in @a _block, including those of its functions.
+	static size_t countNodes(Block const& _block);
+
+private:
+	std::map<std::string, StepMetrics> m_steps;
+};
+
+}
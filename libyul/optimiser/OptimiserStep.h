@@ -24,6 +24,11 @@
 #include <string>
 #include <set>
 
+namespace solidity::util
+{
+class WorkerPool;
+}
+
 namespace solidity::yul
 {
 
@@ -31,6 +36,7 @@ struct Dialect;
 struct Block;
 class YulString;
 class NameDispenser;
+class UnchangedParts;
 
 struct OptimiserStepContext
 {
@@ -39,6 +45,12 @@ struct OptimiserStepContext
 	std::set<YulString> const& reservedIdentifiers;
 	/// The value nullopt represents creation code
 	std::optional<size_t> expectedExecutionsPerDeployment;
+	/// Threads that steps which transform each function on its own may use, if any.
+	/// The result does not depend on it.
+	util::WorkerPool* workers = nullptr;
+	/// Parts of the AST that steps which transform each function on its own already transformed
+	/// without changing them, if they are tracked. Set by the OptimiserSuite for each step.
+	UnchangedParts* unchangedParts = nullptr;
 };
 
 
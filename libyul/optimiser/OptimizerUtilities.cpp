@@ -21,6 +21,9 @@
 
 #include <libyul/optimiser/OptimizerUtilities.h>
 
+#include <libyul/optimiser/ChangeTracker.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/backends/evm/EVMDialect.h>
 
 #include <libyul/Dialect.h>
@@ -28,15 +31,31 @@
 
 #include <liblangutil/Token.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Parallel.h>
 
 #include <range/v3/action/remove_if.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
 using namespace std;
 using namespace solidity;
 using namespace solidity::langutil;
 using namespace solidity::util;
 using namespace solidity::yul;
 
+namespace
+{
+
+/// Code size (see CodeSize) each thread of transformFunctions has to process at least.
+/// Below that, splitting the code and setting up a transformation per thread is assumed to cost
+/// more than running the step concurrently saves. The value is an estimate that has not been
+/// measured yet.
+size_t constexpr minCodeSizePerJob = 2000;
+
+}
+
 void yul::removeEmptyBlocks(Block& _block)
 {
 	auto isEmptyBlock = [](Statement const& _st) -> bool {
@@ -65,6 +84,115 @@ langutil::EVMVersion const yul::evmVersionFromDialect(Dialect const& _dialect)
 	return langutil::EVMVersion();
 }
 
+void yul::transformFunctions(
+	OptimiserStepContext const& _context,
+	Block& _ast,
+	function<function<void(Block&)>()> const& _createTransform,
+	uint64_t _dependencies
+)
+{
+	bool functionGrouped =
+		!_ast.statements.empty() &&
+		holds_alternative<Block>(_ast.statements.front()) &&
+		all_of(
+			_ast.statements.begin() + 1,
+			_ast.statements.end(),
+			[](Statement const& _statement) { return holds_alternative<FunctionDefinition>(_statement); }
+		);
+	if (!functionGrouped)
+	{
+		_createTransform()(_ast);
+		return;
+	}
+
+	// Parts that were already transformed without being changed are left out.
+	vector<size_t> partIndices;
+	size_t codeSize = 0;
+	for (size_t index = 0; index < _ast.statements.size(); ++index)
+	{
+		Statement const& statement = _ast.statements[index];
+		FunctionDefinition const* function = get_if<FunctionDefinition>(&statement);
+		if (_context.unchangedParts && _context.unchangedParts->skip(function ? function->name : YulString{}, _dependencies))
+			continue;
+		partIndices.emplace_back(index);
+		if (_context.workers && _context.workers->jobs() > 1)
+			codeSize += CodeSize::codeSizeIncludingFunctions(statement);
+	}
+	if (partIndices.empty())
+		return;
+
+	size_t jobs = 1;
+	if (_context.workers && _context.workers->jobs() > 1 && partIndices.size() > 1)
+		jobs = min(_context.workers->jobs(), codeSize / minCodeSizePerJob);
+	if (jobs <= 1 && partIndices.size() == _ast.statements.size())
+	{
+		_createTransform()(_ast);
+		return;
+	}
+	jobs = max<size_t>(jobs, 1);
+
+	vector<Block> parts;
+	parts.reserve(partIndices.size());
+	for (size_t index: partIndices)
+	{
+		parts.emplace_back(Block{_ast.debugData, {}});
+		parts.back().statements.emplace_back(std::move(_ast.statements[index]));
+	}
+
+	vector<function<void(Block&)>> transforms;
+	for (size_t thread = 0; thread < min(jobs, parts.size()); ++thread)
+		transforms.emplace_back(_createTransform());
+
+	vector<exception_ptr> failures(parts.size());
+	if (transforms.size() == 1)
+		for (size_t index = 0; index < parts.size(); ++index)
+			try
+			{
+				transforms.front()(parts[index]);
+			}
+			catch (...)
+			{
+				failures[index] = current_exception();
+			}
+	else
+	{
+		// Every thread uses its own transformation and takes the next part that is not processed yet.
+		// The threads of the pool are kept for all steps, so the rule lists they build for the
+		// simplifications are kept as well.
+		atomic<size_t> nextPart{0};
+		_context.workers->run(transforms.size(), [&](size_t _thread) {
+			for (size_t index = nextPart++; index < parts.size(); index = nextPart++)
+				try
+				{
+					transforms[_thread](parts[index]);
+				}
+				catch (...)
+				{
+					failures[index] = current_exception();
+				}
+		});
+	}
+
+	// A transformation of a part may replace the part by several statements.
+	vector<Statement> statements;
+	statements.reserve(_ast.statements.size());
+	auto nextPartIndex = partIndices.begin();
+	for (size_t index = 0; index < _ast.statements.size(); ++index)
+		if (nextPartIndex != partIndices.end() && *nextPartIndex == index)
+		{
+			for (Statement& statement: parts[static_cast<size_t>(nextPartIndex - partIndices.begin())].statements)
+				statements.emplace_back(std::move(statement));
+			++nextPartIndex;
+		}
+		else
+			statements.emplace_back(std::move(_ast.statements[index]));
+	_ast.statements = std::move(statements);
+
+	for (exception_ptr const& failure: failures)
+		if (failure)
+			rethrow_exception(failure);
+}
+
 void StatementRemover::operator()(Block& _block)
 {
 	util::iterateReplacing(
@@ -28,6 +28,7 @@
 #include <libyul/optimiser/ASTWalker.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <functional>
 #include <optional>
 
 namespace solidity::evmasm
@@ -38,6 +39,8 @@ enum class Instruction: uint8_t;
 namespace solidity::yul
 {
 
+struct OptimiserStepContext;
+
 /// Removes statements that are just empty blocks (non-recursive).
 /// If this is run on the outermost block, the FunctionGrouper should be run afterwards to keep
 /// the canonical form.
@@ -54,6 +57,26 @@ std::optional<evmasm::Instruction> toEVMInstruction(Dialect const& _dialect, Yul
 /// It returns the default EVM version if dialect is not an EVMDialect.
 langutil::EVMVersion const evmVersionFromDialect(Dialect const& _dialect);
 
+/// Applies a transformation separately to the top-level code and to each function of the
+/// function-grouped @a _ast, on the threads of the workers of @a _context, if given. Each part is
+/// passed as a block that only contains this part and its statements are moved back into @a _ast
+/// afterwards. @a _createTransform is called once per thread on the calling thread, so that a
+/// transformation can reuse its state for all the parts processed by the same thread.
+/// Parts that the step already transformed without changing them are skipped if the unchanged
+/// parts of @a _context are tracked and @a _dependencies, a hash of the information about the
+/// rest of @a _ast the transformation uses (see DependencyHasher), is the same as back then.
+/// Fewer threads are used if the parts are too small to keep them busy. If @a _ast is not
+/// function-grouped or all parts are transformed on a single thread, a single transformation
+/// is applied to @a _ast itself.
+/// Only suitable for transformations of a part that depend on the other parts through
+/// information computed beforehand at most and that do not create new names.
+void transformFunctions(
+	OptimiserStepContext const& _context,
+	Block& _ast,
+	std::function<std::function<void(Block&)>()> const& _createTransform,
+	uint64_t _dependencies = 0
+);
+
 class StatementRemover: public ASTModifier
 {
 public:
@@ -62,6 +62,7 @@
 #include <libyul/optimiser/LoopInvariantCodeMotion.h>
 #include <libyul/optimiser/Metrics.h>
 #include <libyul/optimiser/NameSimplifier.h>
+#include <libyul/optimiser/OptimiserProfile.h>
 #include <libyul/backends/evm/ConstantOptimiser.h>
 #include <libyul/AsmAnalysis.h>
 #include <libyul/AsmAnalysisInfo.h>
@@ -71,6 +72,7 @@
 
 #include <libyul/backends/evm/NoOutputAssembly.h>
 
+#include <libsolutil/Common.h>
 #include <libsolutil/CommonData.h>
 
 #include <libyul/CompilabilityChecker.h>
@@ -78,28 +80,28 @@
 #include <range/v3/view/map.hpp>
 #include <range/v3/action/remove.hpp>
 
+#include <chrono>
 #include <limits>
 #include <tuple>
 
 #ifdef PROFILE_OPTIMIZER_STEPS
-#include <chrono>
 #include <fmt/format.h>
 #endif
 
 using namespace std;
+using namespace std::chrono;
 using namespace solidity;
 using namespace solidity::yul;
-#ifdef PROFILE_OPTIMIZER_STEPS
-using namespace std::chrono;
-#endif
 
 namespace
 {
 
 #ifdef PROFILE_OPTIMIZER_STEPS
-void outputPerformanceMetrics(map<string, int64_t> const& _metrics)
+void outputPerformanceMetrics(OptimiserProfile const& _profile)
 {
-	vector<pair<string, int64_t>> durations(_metrics.begin(), _metrics.end());
+	vector<pair<string, int64_t>> durations;
+	for (auto const& [step, metrics]: _profile.steps())
+		durations.emplace_back(step, duration_cast<microseconds>(metrics.duration).count());
 	sort(
 		durations.begin(),
 		durations.end(),
@@ -139,9 +141,17 @@ void OptimiserSuite::run(
 	string_view _optimisationSequence,
 	string_view _optimisationCleanupSequence,
 	optional<size_t> _expectedExecutionsPerDeployment,
-	set<YulString> const& _externallyUsedIdentifiers
+	set<YulString> const& _externallyUsedIdentifiers,
+	OptimiserProfile* _profile,
+	util::WorkerPool* _workers
 )
 {
+#ifdef PROFILE_OPTIMIZER_STEPS
+	// Builds with this option print the cost of the steps of every run.
+	OptimiserProfile printedProfile;
+	OptimiserProfile* const requestedProfile = _profile;
+	_profile = &printedProfile;
+#endif
 	EVMDialect const* evmDialect = dynamic_cast<EVMDialect const*>(&_dialect);
 	bool usesOptimizedCodeGenerator =
 		_optimizeStackAllocation &&
@@ -159,9 +169,9 @@ void OptimiserSuite::run(
 	Block& ast = *_object.code;
 
 	NameDispenser dispenser{_dialect, ast, reservedIdentifiers};
-	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment};
+	OptimiserStepContext context{_dialect, dispenser, reservedIdentifiers, _expectedExecutionsPerDeployment, _workers};
 
-	OptimiserSuite suite(context, Debug::None);
+	OptimiserSuite suite(context, Debug::None, _profile);
 
 	// Some steps depend on properties ensured by FunctionHoister, BlockFlattener, FunctionGrouper and
 	// ForLoopInitRewriter. Run them first to be able to run arbitrary sequences safely.
@@ -216,7 +226,9 @@ void OptimiserSuite::run(
 	VarNameCleaner::run(suite.m_context, ast);
 
 #ifdef PROFILE_OPTIMIZER_STEPS
-	outputPerformanceMetrics(suite.m_durationPerStepInMicroseconds);
+	outputPerformanceMetrics(printedProfile);
+	if (requestedProfile)
+		requestedProfile->merge(printedProfile);
 #endif
 
 	*_object.analysisInfo = AsmAnalyzer::analyzeStrictAssertCorrect(_dialect, _object);
@@ -243,42 +255,40 @@ map<string, unique_ptr<OptimiserStep>> optimiserStepCollection()
 
 map<string, unique_ptr<OptimiserStep>> const& OptimiserSuite::allSteps()
 {
-	static map<string, unique_ptr<OptimiserStep>> instance;
-	if (instance.empty())
-		instance = optimiserStepCollection<
-			BlockFlattener,
-			CircularReferencesPruner,
-			CommonSubexpressionEliminator,
-			ConditionalSimplifier,
-			ConditionalUnsimplifier,
-			ControlFlowSimplifier,
-			DeadCodeEliminator,
-			EqualStoreEliminator,
-			EquivalentFunctionCombiner,
-			ExpressionInliner,
-			ExpressionJoiner,
-			ExpressionSimplifier,
-			ExpressionSplitter,
-			ForLoopConditionIntoBody,
-			ForLoopConditionOutOfBody,
-			ForLoopInitRewriter,
-			FullInliner,
-			FunctionGrouper,
-			FunctionHoister,
-			FunctionSpecializer,
-			LiteralRematerialiser,
-			LoadResolver,
-			LoopInvariantCodeMotion,
-			UnusedAssignEliminator,
-			UnusedStoreEliminator,
-			Rematerialiser,
-			SSAReverser,
-			SSATransform,
-			StructuralSimplifier,
-			UnusedFunctionParameterPruner,
-			UnusedPruner,
-			VarDeclInitializer
-		>();
+	static map<string, unique_ptr<OptimiserStep>> const instance = optimiserStepCollection<
+		BlockFlattener,
+		CircularReferencesPruner,
+		CommonSubexpressionEliminator,
+		ConditionalSimplifier,
+		ConditionalUnsimplifier,
+		ControlFlowSimplifier,
+		DeadCodeEliminator,
+		EqualStoreEliminator,
+		EquivalentFunctionCombiner,
+		ExpressionInliner,
+		ExpressionJoiner,
+		ExpressionSimplifier,
+		ExpressionSplitter,
+		ForLoopConditionIntoBody,
+		ForLoopConditionOutOfBody,
+		ForLoopInitRewriter,
+		FullInliner,
+		FunctionGrouper,
+		FunctionHoister,
+		FunctionSpecializer,
+		LiteralRematerialiser,
+		LoadResolver,
+		LoopInvariantCodeMotion,
+		UnusedAssignEliminator,
+		UnusedStoreEliminator,
+		Rematerialiser,
+		SSAReverser,
+		SSATransform,
+		StructuralSimplifier,
+		UnusedFunctionParameterPruner,
+		UnusedPruner,
+		VarDeclInitializer
+	>();
 	// Does not include VarNameCleaner because it destroys the property of unique names.
 	// Does not include NameSimplifier.
 	return instance;
@@ -386,6 +396,7 @@ void OptimiserSuite::validateSequence(string_view _stepAbbreviations)
 void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bool _repeatUntilStable)
 {
 	validateSequence(_stepAbbreviations);
+	ScopedSaveAndRestore repeatedSequence(m_inRepeatedSequence, m_inRepeatedSequence || _repeatUntilStable);
 
 	// This splits 'aaa[bbb]ccc...' into 'aaa' and '[bbb]ccc...'.
 	auto extractNonNestedPrefix = [](string_view _tail) -> tuple<string_view, string_view>
@@ -467,30 +478,80 @@ void OptimiserSuite::runSequence(string_view _stepAbbreviations, Block& _ast, bo
 		if (!_repeatUntilStable)
 			break;
 
-		size_t newSize = CodeSize::codeSizeIncludingFunctions(_ast);
+		size_t newSize = trackedCodeSize(_ast);
 		if (newSize == codeSize)
 			break;
 		codeSize = newSize;
 	}
 }
 
+size_t OptimiserSuite::trackedCodeSize(Block const& _ast)
+{
+	if (!trackChanges())
+		return CodeSize::codeSizeIncludingFunctions(_ast);
+	// Only recomputes the size of the functions that changed.
+	updateChangeTracker(_ast);
+	return m_changeTracker.codeSize();
+}
+
+void OptimiserSuite::updateChangeTracker(Block const& _ast)
+{
+	if (!m_changeTrackerOutdated)
+		return;
+	m_changeTracker.update(_ast);
+	m_changeTrackerOutdated = false;
+}
+
 void OptimiserSuite::runSequence(std::vector<string> const& _steps, Block& _ast)
 {
 	unique_ptr<Block> copy;
 	if (m_debug == Debug::PrintChanges)
 		copy = make_unique<Block>(std::get<Block>(ASTCopier{}(_ast)));
+	// The AST may have been modified outside of the suite since the last step.
+	m_changeTrackerOutdated = true;
+	// The node count after a step is the node count before the next one.
+	size_t nodeCount = m_profile && !_steps.empty() ? OptimiserProfile::countNodes(_ast) : 0;
 	for (string const& step: _steps)
 	{
 		if (m_debug == Debug::PrintStep)
 			cout << "Running " << step << endl;
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point startTime = steady_clock::now();
-#endif
+		// Fingerprinting the AST costs about as much as a cheap step. It is only done where a step
+		// could be skipped, i.e. before a step that left an earlier version unchanged, and before
+		// and after steps that are run again until the AST is stable.
+		bool const trackStep = trackChanges() && m_inRepeatedSequence;
+		if (trackChanges())
+		{
+			auto unchangedVersion = m_unchangedVersion.find(step);
+			if (unchangedVersion != m_unchangedVersion.end() || trackStep)
+				updateChangeTracker(_ast);
+			if (unchangedVersion != m_unchangedVersion.end() && unchangedVersion->second == m_changeTracker.version())
+				continue;
+		}
+		// Steps that transform each function on their own skip the functions they left unchanged
+		// before. This requires the change tracker to be up to date before and after the step.
+		UnchangedParts* unchangedParts =
+			trackStep ?
+			&m_unchangedParts.try_emplace(step, m_changeTracker).first->second :
+			nullptr;
+		ScopedSaveAndRestore contextUnchangedParts(m_context.unchangedParts, std::move(unchangedParts));
+		steady_clock::time_point startTime = m_profile ? steady_clock::now() : steady_clock::time_point{};
 		allSteps().at(step)->run(m_context, _ast);
-#ifdef PROFILE_OPTIMIZER_STEPS
-		steady_clock::time_point endTime = steady_clock::now();
-		m_durationPerStepInMicroseconds[step] += duration_cast<microseconds>(endTime - startTime).count();
-#endif
+		if (m_profile)
+		{
+			steady_clock::duration duration = steady_clock::now() - startTime;
+			size_t newNodeCount = OptimiserProfile::countNodes(_ast);
+			m_profile->record(step, duration, nodeCount, newNodeCount);
+			nodeCount = newNodeCount;
+		}
+		if (trackStep)
+		{
+			size_t version = m_changeTracker.version();
+			if (!m_changeTracker.update(_ast))
+				m_unchangedVersion[step] = version;
+			unchangedParts->update();
+		}
+		else
+			m_changeTrackerOutdated = true;
 		if (m_debug == Debug::PrintChanges)
 		{
 			// TODO should add switch to also compare variable names!
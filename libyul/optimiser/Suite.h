@@ -23,10 +23,12 @@
 
 #include <libyul/ASTForward.h>
 #include <libyul/YulString.h>
+#include <libyul/optimiser/ChangeTracker.h>
 #include <libyul/optimiser/OptimiserStep.h>
 #include <libyul/optimiser/NameDispenser.h>
 #include <liblangutil/EVMVersion.h>
 
+#include <map>
 #include <set>
 #include <string>
 #include <string_view>
@@ -39,6 +41,7 @@ struct AsmAnalysisInfo;
 struct Dialect;
 class GasMeter;
 struct Object;
+class OptimiserProfile;
 
 /**
  * Optimiser suite that combines all steps and also provides the settings for the heuristics.
@@ -59,9 +62,13 @@ public:
 		PrintStep,
 		PrintChanges
 	};
-	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None): m_context(_context), m_debug(_debug) {}
+	/// If @a _profile is given, the cost of each step run by the suite is recorded there.
+	OptimiserSuite(OptimiserStepContext& _context, Debug _debug = Debug::None, OptimiserProfile* _profile = nullptr):
+		m_context(_context), m_debug(_debug), m_profile(_profile) {}
 
 	/// The value nullopt for `_expectedExecutionsPerDeployment` represents creation code.
+	/// If @a _profile is given, the cost of each step is recorded there.
+	/// Steps that transform each function on its own use the threads of @a _workers, if given.
 	static void run(
 		Dialect const& _dialect,
 		GasMeter const* _meter,
@@ -70,7 +77,9 @@ public:
 		std::string_view _optimisationSequence,
 		std::string_view _optimisationCleanupSequence,
 		std::optional<size_t> _expectedExecutionsPerDeployment,
-		std::set<YulString> const& _externallyUsedIdentifiers = {}
+		std::set<YulString> const& _externallyUsedIdentifiers = {},
+		OptimiserProfile* _profile = nullptr,
+		util::WorkerPool* _workers = nullptr
 	);
 
 	/// Ensures that specified sequence of step abbreviations is well-formed and can be executed.
@@ -85,11 +94,29 @@ public:
 	static std::map<char, std::string> const& stepAbbreviationToNameMap();
 
 private:
+	bool trackChanges() const { return m_debug == Debug::None; }
+	/// @returns the code size of @a _ast including functions.
+	size_t trackedCodeSize(Block const& _ast);
+	/// Updates the change tracker unless it is known to be up to date with @a _ast.
+	void updateChangeTracker(Block const& _ast);
+
 	OptimiserStepContext& m_context;
 	Debug m_debug;
-#ifdef PROFILE_OPTIMIZER_STEPS
-	std::map<std::string, int64_t> m_durationPerStepInMicroseconds;
-#endif
+	OptimiserProfile* m_profile = nullptr;
+	/// Tracks changes to the AST between steps, unless debug output is requested.
+	ChangeTracker m_changeTracker;
+	/// Whether the AST may have changed since the last update of m_changeTracker.
+	bool m_changeTrackerOutdated = true;
+	/// Whether the steps currently run are part of a sequence repeated until the AST is stable.
+	/// Only these steps are fingerprinted after running, since they are likely to be run again
+	/// on the same AST.
+	bool m_inRepeatedSequence = false;
+	/// Version of the AST in which each step was last run without changing it. Running the
+	/// step again is skipped as long as the AST stays in this version.
+	std::map<std::string, size_t> m_unchangedVersion;
+	/// Functions that each step transformed without changing them, for the steps that
+	/// transform each function on their own.
+	std::map<std::string, UnchangedParts> m_unchangedParts;
 };
 
 }
@@ -22,6 +22,7 @@
 
 #include <libyul/optimiser/UnusedAssignEliminator.h>
 
+#include <libyul/optimiser/ChangeTracker.h>
 #include <libyul/optimiser/Semantics.h>
 #include <libyul/optimiser/OptimizerUtilities.h>
 #include <libyul/ControlFlowSideEffectsCollector.h>
@@ -40,17 +41,31 @@ using namespace solidity::yul;
 
 void UnusedAssignEliminator::run(OptimiserStepContext& _context, Block& _ast)
 {
-	UnusedAssignEliminator uae{
-		_context.dialect,
-		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed()
-	};
-	uae(_ast);
-
-	uae.m_storesToRemove += uae.m_allStores - uae.m_usedStores;
-
-	set<Statement const*> toRemove{uae.m_storesToRemove.begin(), uae.m_storesToRemove.end()};
-	StatementRemover remover{toRemove};
-	remover(_ast);
+	map<YulString, ControlFlowSideEffects> controlFlowSideEffects =
+		ControlFlowSideEffectsCollector{_context.dialect, _ast}.functionSideEffectsNamed();
+	transformFunctions(
+		_context,
+		_ast,
+		[&]() -> function<void(Block&)> {
+			auto uae = make_shared<UnusedAssignEliminator>(_context.dialect, controlFlowSideEffects);
+			return [uae](Block& _part) {
+				(*uae)(_part);
+
+				uae->m_storesToRemove += uae->m_allStores - uae->m_usedStores;
+
+				set<Statement const*> toRemove{uae->m_storesToRemove.begin(), uae->m_storesToRemove.end()};
+				StatementRemover remover{toRemove};
+				remover(_part);
+
+				// Only the state of the top-level code remains, functions restore it after processing.
+				uae->m_storesToRemove.clear();
+				uae->m_allStores.clear();
+				uae->m_usedStores.clear();
+				uae->m_activeStores.clear();
+			};
+		},
+		DependencyHasher{}(controlFlowSideEffects).hash()
+	);
 }
 
 void UnusedAssignEliminator::operator()(Identifier const& _identifier)
@@ -31,6 +31,7 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolidity/ast/ASTJsonExporter.h>
 #include <libsolidity/ast/ASTJsonImporter.h>
+#include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/analysis/NameAndTypeResolver.h>
 #include <libsolidity/interface/CompilerStack.h>
 #include <libsolidity/interface/StandardCompiler.h>
@@ -56,9 +57,11 @@
 #include <libsolutil/CommonData.h>
 #include <libsolutil/CommonIO.h>
 #include <libsolutil/JSON.h>
+#include <libsolutil/Keccak256.h>
 
 #include <algorithm>
 #include <fstream>
+#include <list>
 #include <memory>
 
 #include <range/v3/view/map.hpp>
@@ -157,7 +160,8 @@ static bool needsHumanTargetedStdout(CommandLineOptions const& _options)
 		_options.compiler.outputs.natspecDev ||
 		_options.compiler.outputs.opcodes ||
 		_options.compiler.outputs.signatureHashes ||
-		_options.compiler.outputs.storageLayout;
+		_options.compiler.outputs.storageLayout ||
+		_options.compiler.outputs.optimizerProfile;
 }
 
 static bool coloredOutput(CommandLineOptions const& _options)
@@ -292,6 +296,24 @@ void CommandLineInterface::handleIROptimizedAst(string const& _contractName)
 	}
 }
 
+void CommandLineInterface::handleOptimizerProfile(string const& _contractName)
+{
+	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+
+	if (!m_options.compiler.outputs.optimizerProfile)
+		return;
+
+	Json::Value profile = m_compiler->optimiserProfile(_contractName);
+	if (profile.isNull())
+		return;
+
+	string data = util::jsonPrint(profile, m_options.formatting.json);
+	if (!m_options.output.dir.empty())
+		createFile(m_compiler->filesystemFriendlyName(_contractName) + "_optimizer_profile.json", data);
+	else
+		sout() << "Optimizer profile:" << endl << data << endl;
+}
+
 void CommandLineInterface::handleBytecode(string const& _contract)
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
@@ -560,6 +582,7 @@ void CommandLineInterface::readInputFiles()
 
 	if (
 		m_options.input.mode != InputMode::LanguageServer &&
+		m_options.input.mode != InputMode::Server &&
 		m_fileReader.sourceUnits().empty() &&
 		!m_standardJsonInput.has_value()
 	)
@@ -683,13 +706,19 @@ void CommandLineInterface::processInput()
 		solAssert(m_standardJsonInput.has_value());
 
 		StandardCompiler compiler(m_universalCallback.callback(), m_options.formatting.json);
-		sout() << compiler.compile(std::move(m_standardJsonInput.value())) << endl;
+		if (!m_options.cache.directory.empty())
+			compiler.setCache(make_shared<CompilationCache>(m_options.cache.directory, m_options.cache.maxSize));
+		compiler.compile(m_standardJsonInput.value(), sout());
+		sout() << endl;
 		m_standardJsonInput.reset();
 		break;
 	}
 	case InputMode::LanguageServer:
 		serveLSP();
 		break;
+	case InputMode::Server:
+		serveCompileRequests();
+		break;
 	case InputMode::Assembler:
 		assembleYul(m_options.assembly.inputLanguage, m_options.assembly.targetMachine);
 		break;
@@ -740,6 +769,7 @@ void CommandLineInterface::compile()
 		m_compiler->setEVMVersion(m_options.output.evmVersion);
 		m_compiler->setEOFVersion(m_options.output.eofVersion);
 		m_compiler->setRevertStringBehaviour(m_options.output.revertStrings);
+		m_compiler->setParallelJobs(m_options.output.parallelJobs);
 		if (m_options.output.debugInfoSelection.has_value())
 			m_compiler->selectDebugInfo(m_options.output.debugInfoSelection.value());
 		// TODO: Perhaps we should not compile unless requested
@@ -749,6 +779,7 @@ void CommandLineInterface::compile()
 			m_options.compiler.outputs.irAstJson ||
 			m_options.compiler.outputs.irOptimizedAstJson
 		);
+		m_compiler->enableOptimiserProfiling(m_options.compiler.outputs.optimizerProfile);
 		m_compiler->enableEvmBytecodeGeneration(
 			m_options.compiler.estimateGas ||
 			m_options.compiler.outputs.asm_ ||
@@ -969,6 +1000,73 @@ void CommandLineInterface::serveLSP()
 		solThrow(CommandLineExecutionError, "LSP terminated abnormally.");
 }
 
+void CommandLineInterface::serveCompileRequests()
+{
+	solAssert(m_options.input.mode == InputMode::Server);
+
+	// The output for an input that did not read any files only depends on the input itself.
+	// The most recently used ones are kept in memory.
+	size_t const maxMemoizedOutputs = 64;
+	list<pair<h256, string>> memoizedOutputs;
+	map<h256, list<pair<h256, string>>::iterator> memoizedOutputsByInput;
+
+	bool readCallbackUsed = false;
+	ReadCallback::Callback readFile = m_universalCallback.callback();
+	StandardCompiler compiler(
+		[&](string const& _kind, string const& _data) {
+			readCallbackUsed = true;
+			// Settings variants and the cache may read the same file more than once per request.
+			if (_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile))
+				if (auto source = m_fileReader.sourceUnits().find(_data); source != m_fileReader.sourceUnits().end())
+					return ReadCallback::Result{true, source->second};
+			return readFile(_kind, _data);
+		},
+		m_options.formatting.json
+	);
+	if (!m_options.cache.directory.empty())
+		compiler.setCache(make_shared<CompilationCache>(m_options.cache.directory, m_options.cache.maxSize));
+	// Requests often compile the same sources with different outputs or code generator settings.
+	compiler.setReuseAnalysis(true);
+	// The YulString repository and the dialects built on it are not reset between requests,
+	// since the kept analysis refers to them and the identifiers mostly repeat.
+
+	string input;
+	while (getline(m_sin, input))
+	{
+		if (input.find_first_not_of(" \t\r") == string::npos)
+			continue;
+
+		h256 const inputHash = keccak256(input);
+		if (auto memoized = memoizedOutputsByInput.find(inputHash); memoized != memoizedOutputsByInput.end())
+		{
+			memoizedOutputs.splice(memoizedOutputs.begin(), memoizedOutputs, memoized->second);
+			sout() << memoized->second->second << endl;
+			continue;
+		}
+
+		// Files are read from disk again for each request because they may have changed.
+		m_fileReader.setSourceUnits({});
+		readCallbackUsed = false;
+		string output = compiler.compile(input);
+		sout() << output << endl;
+		// Optimiser profiles measure the run that produced them and must not be replayed.
+		Json::Value parsedInput;
+		bool const profileRequested =
+			jsonParseStrict(input, parsedInput) &&
+			StandardCompiler::isOptimizerProfileRequested(parsedInput);
+		if (!readCallbackUsed && !profileRequested)
+		{
+			memoizedOutputs.emplace_front(inputHash, std::move(output));
+			memoizedOutputsByInput[inputHash] = memoizedOutputs.begin();
+			if (memoizedOutputs.size() > maxMemoizedOutputs)
+			{
+				memoizedOutputsByInput.erase(memoizedOutputs.back().first);
+				memoizedOutputs.pop_back();
+			}
+		}
+	}
+}
+
 void CommandLineInterface::link()
 {
 	solAssert(m_options.input.mode == InputMode::Linker);
@@ -1158,6 +1256,8 @@ void CommandLineInterface::assembleYul(yul::YulStack::Language _language, yul::Y
 void CommandLineInterface::outputCompilationResults()
 {
 	solAssert(CompilerInputModes.count(m_options.input.mode) == 1);
+	// The outputs are produced from the types of the analyzed sources.
+	TypeProvider::Scope typeProviderScope{m_compiler->typeProvider()};
 
 	handleCombinedJSON();
 
@@ -1202,6 +1302,7 @@ void CommandLineInterface::outputCompilationResults()
 		handleIRAst(contract);
 		handleIROptimized(contract);
 		handleIROptimizedAst(contract);
+		handleOptimizerProfile(contract);
 		handleSignatureHashes(contract);
 		handleMetadata(contract);
 		handleABI(contract);
@@ -85,6 +85,8 @@ private:
 	void printLicense();
 	void compile();
 	void serveLSP();
+	/// Compiles the standard JSON inputs read from standard input line by line until it ends.
+	void serveCompileRequests();
 	void link();
 	void writeLinkedFiles();
 	/// @returns the ``// <identifier> -> name`` hint for library placeholders.
@@ -104,6 +106,7 @@ private:
 	void handleIRAst(std::string const& _contract);
 	void handleIROptimized(std::string const& _contract);
 	void handleIROptimizedAst(std::string const& _contract);
+	void handleOptimizerProfile(std::string const& _contract);
 	void handleBytecode(std::string const& _contract);
 	void handleSignatureHashes(std::string const& _contract);
 	void handleMetadata(std::string const& _contract);
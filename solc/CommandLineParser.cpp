@@ -30,6 +30,8 @@
 #include <range/v3/view/filter.hpp>
 #include <range/v3/range/conversion.hpp>
 
+#include <limits>
+
 using namespace std;
 using namespace solidity::langutil;
 
@@ -40,6 +42,8 @@ namespace solidity::frontend
 
 static string const g_strAllowPaths = "allow-paths";
 static string const g_strBasePath = "base-path";
+static string const g_strCacheDir = "cache-dir";
+static string const g_strCacheSize = "cache-size";
 static string const g_strIncludePath = "include-path";
 static string const g_strAssemble = "assemble";
 static string const g_strCombinedJson = "combined-json";
@@ -53,6 +57,7 @@ static string const g_strGas = "gas";
 static string const g_strHelp = "help";
 static string const g_strImportAst = "import-ast";
 static string const g_strInputFile = "input-file";
+static string const g_strJobs = "jobs";
 static string const g_strYul = "yul";
 static string const g_strYulDialect = "yul-dialect";
 static string const g_strDebugInfo = "debug-info";
@@ -101,6 +106,7 @@ static set<string> const g_revertStringsArgs
 
 static string const g_strSources = "sources";
 static string const g_strSourceList = "sourceList";
+static string const g_strServer = "server";
 static string const g_strStandardJSON = "standard-json";
 static string const g_strStrictAssembly = "strict-assembly";
 static string const g_strSwarm = "swarm";
@@ -142,6 +148,7 @@ static map<InputMode, string> const g_inputModeName = {
 	{InputMode::StandardJson, "standard JSON"},
 	{InputMode::Linker, "linker"},
 	{InputMode::LanguageServer, "language server (LSP)"},
+	{InputMode::Server, "compile server"},
 };
 
 void CommandLineParser::checkMutuallyExclusive(vector<string> const& _optionNames)
@@ -235,6 +242,9 @@ bool CommandLineOptions::operator==(CommandLineOptions const& _other) const noex
 		output.debugInfoSelection == _other.output.debugInfoSelection &&
 		output.stopAfter == _other.output.stopAfter &&
 		output.eofVersion == _other.output.eofVersion &&
+		output.parallelJobs == _other.output.parallelJobs &&
+		cache.directory == _other.cache.directory &&
+		cache.maxSize == _other.cache.maxSize &&
 		input.mode == _other.input.mode &&
 		assembly.targetMachine == _other.assembly.targetMachine &&
 		assembly.inputLanguage == _other.assembly.inputLanguage &&
@@ -308,7 +318,7 @@ void CommandLineParser::parseInputPathsAndRemappings()
 				if (!remapping.has_value())
 					solThrow(CommandLineValidationError, "Invalid remapping: \"" + positionalArg + "\".");
 
-				if (m_options.input.mode == InputMode::StandardJson)
+				if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::Server)
 					solThrow(
 						CommandLineValidationError,
 						"Import remappings are not accepted on the command line in Standard JSON mode.\n"
@@ -348,6 +358,15 @@ void CommandLineParser::parseInputPathsAndRemappings()
 			// Keep it working that way for backwards-compatibility.
 			m_options.input.addStdin = true;
 	}
+	else if (m_options.input.mode == InputMode::Server)
+	{
+		if (!m_options.input.paths.empty() || m_options.input.addStdin)
+			solThrow(
+				CommandLineValidationError,
+				"Input files are not accepted by --" + g_strServer + ".\n"
+				"Please send the standard JSON inputs on standard input, one per line."
+			);
+	}
 	else if (m_options.input.paths.size() == 0 && !m_options.input.addStdin)
 		solThrow(
 			CommandLineValidationError,
@@ -483,6 +502,7 @@ void CommandLineParser::parseOutputSelection()
 		case InputMode::Assembler:
 			return util::contains(assemblerModeOutputs, _outputName);
 		case InputMode::StandardJson:
+		case InputMode::Server:
 		case InputMode::Linker:
 			return false;
 		}
@@ -631,9 +651,34 @@ General Information)").c_str(),
 			po::value<string>()->value_name("stage"),
 			"Stop execution after the given compiler stage. Valid options: \"parsing\"."
 		)
+		(
+			g_strJobs.c_str(),
+			po::value<unsigned>()->value_name("n"),
+			"Number of threads used to optimize and assemble independent contracts when compiling via the IR, "
+			"or to optimize the sub-assemblies of a contract otherwise. "
+			"Threads not needed for the contracts are used to optimize the Yul functions of each contract. "
+			"The output does not depend on this setting. Defaults to 1."
+		)
 	;
 	desc.add(outputOptions);
 
+	po::options_description cacheOptions("Compilation Cache Options");
+	cacheOptions.add_options()
+		(
+			g_strCacheDir.c_str(),
+			po::value<string>()->value_name("path"),
+			("Reuse the outputs of earlier compilations of identical standard JSON input stored in the given directory "
+			"and store new ones there. Only supported together with --" + g_strStandardJSON + " and --" + g_strServer + ".").c_str()
+		)
+		(
+			g_strCacheSize.c_str(),
+			po::value<uint64_t>()->value_name("MiB"),
+			"Maximum total size of the entries in the cache directory. "
+			"The least recently used entries are removed when it is exceeded. Defaults to 1024."
+		)
+	;
+	desc.add(cacheOptions);
+
 	po::options_description alternativeInputModes("Alternative Input Modes");
 	alternativeInputModes.add_options()
 		(
@@ -664,6 +709,12 @@ General Information)").c_str(),
 			"Supported Inputs is the output of the --" + g_strStandardJSON + " or the one produced by "
 			"--" + g_strCombinedJson + " " + CombinedJsonRequests::componentName(&CombinedJsonRequests::ast)).c_str()
 		)
+		(
+			g_strServer.c_str(),
+			"Switch to compile server mode. Reads Standard JSON inputs from standard input, one per line, "
+			"and writes the output of each as a single line to standard output. "
+			"State is kept between the inputs, so that repeated compilations are faster."
+		)
 		(
 			g_strLSP.c_str(),
 			"Switch to language server mode (\"LSP\"). Allows the compiler to be used as an analysis backend "
@@ -738,6 +789,7 @@ General Information)").c_str(),
 		(CompilerOutputs::componentName(&CompilerOutputs::irAstJson).c_str(), "AST of Intermediate Representation (IR) of all contracts in a compact JSON format.")
 		(CompilerOutputs::componentName(&CompilerOutputs::irOptimized).c_str(), "Optimized Intermediate Representation (IR) of all contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::irOptimizedAstJson).c_str(), "AST of optimized Intermediate Representation (IR) of all contracts in a compact JSON format.")
+		(CompilerOutputs::componentName(&CompilerOutputs::optimizerProfile).c_str(), "Wall time, invocations and AST node counts of the Yul optimizer steps run on the IR of all contracts, in JSON format.")
 		(CompilerOutputs::componentName(&CompilerOutputs::signatureHashes).c_str(), "Function signature hashes of the contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::natspecUser).c_str(), "Natspec user documentation of all contracts.")
 		(CompilerOutputs::componentName(&CompilerOutputs::natspecDev).c_str(), "Natspec developer documentation of all contracts.")
@@ -932,6 +984,7 @@ void CommandLineParser::processArgs()
 		g_strYul,
 		g_strImportAst,
 		g_strLSP,
+		g_strServer,
 	});
 
 	if (m_args.count(g_strHelp) > 0)
@@ -944,6 +997,8 @@ void CommandLineParser::processArgs()
 		m_options.input.mode = InputMode::StandardJson;
 	else if (m_args.count(g_strLSP))
 		m_options.input.mode = InputMode::LanguageServer;
+	else if (m_args.count(g_strServer))
+		m_options.input.mode = InputMode::Server;
 	else if (m_args.count(g_strAssemble) > 0 || m_args.count(g_strStrictAssembly) > 0 || m_args.count(g_strYul) > 0)
 		m_options.input.mode = InputMode::Assembler;
 	else if (m_args.count(g_strLink) > 0)
@@ -965,6 +1020,9 @@ void CommandLineParser::processArgs()
 		{g_strErrorRecovery, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strExperimentalViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strViaIR, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strJobs, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
+		{g_strCacheDir, {InputMode::StandardJson, InputMode::Server}},
+		{g_strCacheSize, {InputMode::StandardJson, InputMode::Server}},
 		{g_strMetadataLiteral, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strNoCBORMetadata, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
 		{g_strMetadataHash, {InputMode::Compiler, InputMode::CompilerWithASTImport}},
@@ -1071,6 +1129,28 @@ void CommandLineParser::processArgs()
 			solThrow(CommandLineValidationError, "To use 'snippet' with --" + g_strDebugInfo + " you must select also 'location'.");
 	}
 
+	if (m_args.count(g_strJobs))
+	{
+		m_options.output.parallelJobs = m_args[g_strJobs].as<unsigned>();
+		if (m_options.output.parallelJobs == 0)
+			solThrow(CommandLineValidationError, "--" + g_strJobs + " must be at least 1.");
+	}
+
+	if (m_args.count(g_strCacheDir))
+		m_options.cache.directory = m_args[g_strCacheDir].as<string>();
+	if (m_args.count(g_strCacheSize))
+	{
+		if (m_options.cache.directory.empty())
+			solThrow(CommandLineValidationError, "--" + g_strCacheSize + " requires --" + g_strCacheDir + ".");
+		uint64_t const maxSizeInMiB = m_args[g_strCacheSize].as<uint64_t>();
+		if (maxSizeInMiB > numeric_limits<uint64_t>::max() / (1024 * 1024))
+			solThrow(
+				CommandLineValidationError,
+				"--" + g_strCacheSize + " must be at most " + to_string(numeric_limits<uint64_t>::max() / (1024 * 1024)) + "."
+			);
+		m_options.cache.maxSize = maxSizeInMiB * 1024 * 1024;
+	}
+
 	parseCombinedJsonOption();
 
 	if (m_args.count(g_strOutputDir))
@@ -1087,6 +1167,12 @@ void CommandLineParser::processArgs()
 		m_options.formatting.json.format = util::JsonFormat::Pretty;
 		m_options.formatting.json.indent = m_args[g_strJsonIndent].as<uint32_t>();
 	}
+	if (m_options.input.mode == InputMode::Server && m_options.formatting.json.format != util::JsonFormat::Compact)
+		solThrow(
+			CommandLineValidationError,
+			"Options --" + g_strPrettyJson + " and --" + g_strJsonIndent + " are not supported by --" + g_strServer + ", "
+			"which writes every output as a single line."
+		);
 
 	parseOutputSelection();
 
@@ -1127,7 +1213,7 @@ void CommandLineParser::processArgs()
 
 	parseInputPathsAndRemappings();
 
-	if (m_options.input.mode == InputMode::StandardJson)
+	if (m_options.input.mode == InputMode::StandardJson || m_options.input.mode == InputMode::Server)
 		return;
 
 	if (m_args.count(g_strLibraries))
@@ -57,6 +57,7 @@ enum class InputMode
 	Linker,
 	Assembler,
 	LanguageServer,
+	Server,
 };
 
 struct CompilerOutputs
@@ -80,6 +81,7 @@ struct CompilerOutputs
 			{"ir-ast-json", &CompilerOutputs::irAstJson},
 			{"ir-optimized", &CompilerOutputs::irOptimized},
 			{"ir-optimized-ast-json", &CompilerOutputs::irOptimizedAstJson},
+			{"optimizer-profile", &CompilerOutputs::optimizerProfile},
 			{"hashes", &CompilerOutputs::signatureHashes},
 			{"userdoc", &CompilerOutputs::natspecUser},
 			{"devdoc", &CompilerOutputs::natspecDev},
@@ -100,6 +102,7 @@ struct CompilerOutputs
 	bool irAstJson = false;
 	bool irOptimized = false;
 	bool irOptimizedAstJson = false;
+	bool optimizerProfile = false;
 	bool signatureHashes = false;
 	bool natspecUser = false;
 	bool natspecDev = false;
@@ -187,8 +190,15 @@ struct CommandLineOptions
 		std::optional<langutil::DebugInfoSelection> debugInfoSelection;
 		CompilerStack::State stopAfter = CompilerStack::State::CompilationSuccessful;
 		std::optional<uint8_t> eofVersion;
+		size_t parallelJobs = 1;
 	} output;
 
+	struct
+	{
+		boost::filesystem::path directory;
+		uint64_t maxSize = uint64_t(1024) * 1024 * 1024;
+	} cache;
+
 	struct
 	{
 		yul::YulStack::Machine targetMachine = yul::YulStack::Machine::EVM;
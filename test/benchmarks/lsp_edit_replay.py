@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""
+Replays a sequence of edits against `solc --lsp` on a synthetic project and reports the latency
+of every round trip.
+
+Each edit is sent as a textDocument/didChange notification followed by a
+textDocument/semanticTokens/full request for the same file. The latency is measured until the
+response to that request arrives, i.e. it includes the analysis triggered by the change and the
+publishing of diagnostics. Requests without a preceding edit are measured separately.
+"""
+
+import argparse
+import json
+import statistics
+import subprocess
+import tempfile
+import time
+from pathlib import Path
+from typing import List, Optional
+
+
+class LSPClient:
+    def __init__(self, solc_path: str):
+        self.process = subprocess.Popen(
+            [solc_path, '--lsp'],
+            stdin=subprocess.PIPE,
+            stdout=subprocess.PIPE,
+            stderr=subprocess.DEVNULL,
+        )
+        self.next_id = 1
+
+    def close(self) -> None:
+        self.process.kill()
+        self.process.wait(timeout=2.0)
+
+    def send(self, method: str, params: dict, request_id: Optional[int] = None) -> None:
+        message = {'jsonrpc': '2.0', 'method': method, 'params': params}
+        if request_id is not None:
+            message['id'] = request_id
+        body = json.dumps(message).encode('utf-8')
+        assert self.process.stdin is not None
+        self.process.stdin.write(f'Content-Length: {len(body)}\r\n\r\n'.encode('utf-8') + body)
+        self.process.stdin.flush()
+
+    def receive(self) -> dict:
+        assert self.process.stdout is not None
+        size = None
+        while True:
+            line = self.process.stdout.readline().decode('utf-8')
+            if not line:
+                raise RuntimeError('solc terminated')
+            line = line.rstrip('\r\n')
+            if line == '':
+                break
+            if line.startswith('Content-Length: '):
+                size = int(line[len('Content-Length: '):])
+        assert size is not None
+        return json.loads(self.process.stdout.read(size).decode('utf-8'))
+
+    def request(self, method: str, params: dict) -> dict:
+        request_id = self.next_id
+        self.next_id += 1
+        self.send(method, params, request_id)
+        while True:
+            message = self.receive()
+            if message.get('id') == request_id:
+                return message
+
+
+def create_project(directory: Path, file_count: int, functions_per_file: int) -> List[Path]:
+    files = []
+    for index in range(file_count):
+        imports = ''.join(
+            f'import "./C{dependency}.sol";\n'
+            for dependency in sorted({index - 1, index // 2} - {index})
+            if dependency >= 0
+        )
+        functions = ''.join(
+            f'    function f{function}(uint x) public pure returns (uint) {{ return x * {function + 1} + {index}; }}\n'
+            for function in range(functions_per_file)
+        )
+        path = directory / f'C{index}.sol'
+        path.write_text(
+            '// SPDX-License-Identifier: GPL-3.0\n'
+            'pragma solidity >=0.0;\n'
+            f'{imports}'
+            f'contract C{index} {{\n'
+            f'{functions}'
+            '}\n',
+            encoding='utf-8'
+        )
+        files.append(path)
+    return files
+
+
+def report(name: str, latencies: List[float]) -> None:
+    if not latencies:
+        return
+    ordered = sorted(latencies)
+    percentile_95 = ordered[min(len(ordered) - 1, int(len(ordered) * 0.95))]
+    print(
+        f'{name:<24} n={len(latencies):<4} '
+        f'median={statistics.median(latencies) * 1000:8.1f} ms  '
+        f'p95={percentile_95 * 1000:8.1f} ms  '
+        f'max={ordered[-1] * 1000:8.1f} ms'
+    )
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('solc_path', nargs='?', default='solc', help='Path to the solc binary.')
+    parser.add_argument('--files', type=int, default=400, help='Number of source files in the project.')
+    parser.add_argument('--functions', type=int, default=20, help='Number of functions per source file.')
+    parser.add_argument('--edits', type=int, default=50, help='Number of edits to replay.')
+    options = parser.parse_args()
+
+    with tempfile.TemporaryDirectory(prefix='solc-lsp-benchmark-') as directory:
+        files = create_project(Path(directory), options.files, options.functions)
+        edited_file = files[len(files) // 2]
+        uri = edited_file.as_uri()
+        text = edited_file.read_text(encoding='utf-8')
+
+        client = LSPClient(options.solc_path)
+        try:
+            start = time.perf_counter()
+            client.request('initialize', {'rootUri': Path(directory).as_uri(), 'capabilities': {}})
+            client.send('initialized', {})
+            client.send('textDocument/didOpen', {
+                'textDocument': {'uri': uri, 'languageId': 'solidity', 'version': 1, 'text': text}
+            })
+            client.request('textDocument/semanticTokens/full', {'textDocument': {'uri': uri}})
+            print(f'{options.files} files, initial analysis: {(time.perf_counter() - start) * 1000:.1f} ms')
+
+            edit_latencies = []
+            query_latencies = []
+            for edit in range(options.edits):
+                # Appends a character to a comment, so that the source stays valid.
+                start = time.perf_counter()
+                client.send('textDocument/didChange', {
+                    'textDocument': {'uri': uri, 'version': edit + 2},
+                    'contentChanges': [{
+                        'range': {'start': {'line': 0, 'character': 2}, 'end': {'line': 0, 'character': 2}},
+                        'text': ' ',
+                    }],
+                })
+                client.request('textDocument/semanticTokens/full', {'textDocument': {'uri': uri}})
+                edit_latencies.append(time.perf_counter() - start)
+
+                start = time.perf_counter()
+                client.request('textDocument/semanticTokens/full', {'textDocument': {'uri': uri}})
+                query_latencies.append(time.perf_counter() - start)
+
+            report('edit + semantic tokens', edit_latencies)
+            report('semantic tokens only', query_latencies)
+        finally:
+            client.close()
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+"""
+Compiles a synthetic project with many contracts through `solc --standard-json` and reports the
+wall-clock time and the peak resident set size of every given solc binary.
+
+All outputs that grow with the size of the contracts are requested, so that the run is dominated
+by producing and serializing the output rather than by the compilation itself. Passing two
+binaries, e.g. one built before and one after a change, compares them on the same input.
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import tempfile
+import time
+from pathlib import Path
+from typing import Tuple
+
+
+def create_input(contract_count: int, functions_per_contract: int, via_ir: bool) -> dict:
+    sources = {}
+    for index in range(contract_count):
+        functions = ''.join(
+            f'    function f{function}(uint[] memory x, string memory s) public pure returns (uint, bytes memory) {{\n'
+            f'        return (x.length * {function + 1} + {index}, abi.encode(s, x));\n'
+            '    }\n'
+            for function in range(functions_per_contract)
+        )
+        sources[f'C{index}.sol'] = {'content': (
+            '// SPDX-License-Identifier: GPL-3.0\n'
+            'pragma solidity >=0.0;\n'
+            f'contract C{index} {{\n'
+            f'{functions}'
+            '}\n'
+        )}
+    return {
+        'language': 'Solidity',
+        'sources': sources,
+        'settings': {
+            'viaIR': via_ir,
+            'optimizer': {'enabled': True},
+            'outputSelection': {'*': {
+                '*': ['abi', 'metadata', 'evm.bytecode', 'evm.deployedBytecode', 'evm.assembly', 'evm.legacyAssembly'],
+                '': ['ast'],
+            }},
+        },
+    }
+
+
+def run(solc_path: str, input_path: Path) -> Tuple[float, int, int]:
+    """Returns the wall-clock time, the peak RSS in KiB and the size of the output in bytes."""
+    with open(input_path, 'rb') as input_file, tempfile.TemporaryFile() as output_file:
+        start = time.perf_counter()
+        process = subprocess.Popen([solc_path, '--standard-json'], stdin=input_file, stdout=output_file)
+        _, status, usage = os.wait4(process.pid, 0)
+        elapsed = time.perf_counter() - start
+        process.returncode = os.waitstatus_to_exitcode(status)
+        if process.returncode != 0:
+            raise RuntimeError(f'{solc_path} exited with code {process.returncode}')
+        output_size = output_file.seek(0, os.SEEK_END)
+    return elapsed, usage.ru_maxrss, output_size
+
+
+def main() -> None:
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('solc_paths', nargs='*', default=['solc'], help='Paths to the solc binaries to compare.')
+    parser.add_argument('--contracts', type=int, default=150, help='Number of contracts.')
+    parser.add_argument('--functions', type=int, default=20, help='Number of functions per contract.')
+    parser.add_argument('--via-ir', action='store_true', help='Compile via the IR.')
+    parser.add_argument('--repetitions', type=int, default=3, help='Number of runs per binary.')
+    options = parser.parse_args()
+
+    with tempfile.TemporaryDirectory(prefix='solc-standard-json-benchmark-') as directory:
+        input_path = Path(directory) / 'input.json'
+        input_path.write_text(
+            json.dumps(create_input(options.contracts, options.functions, options.via_ir)),
+            encoding='utf-8'
+        )
+        for solc_path in options.solc_paths:
+            results = [run(solc_path, input_path) for _ in range(options.repetitions)]
+            print(
+                f'{solc_path}: '
+                f'min time {min(result[0] for result in results):.2f} s, '
+                f'max RSS {max(result[1] for result in results) / 1024:.1f} MiB, '
+                f'output {results[0][2] / 1024 / 1024:.1f} MiB'
+            )
+
+
+if __name__ == '__main__':
+    main()
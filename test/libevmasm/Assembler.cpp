@@ -420,6 +420,85 @@ BOOST_AUTO_TEST_CASE(subobject_encode_decode)
 	BOOST_CHECK(assembly.decodeSubPath(assembly.encodeSubPath(subPath)) == subPath);
 }
 
+BOOST_AUTO_TEST_CASE(parallel_sub_assembly_optimisation)
+{
+	EVMVersion evmVersion = solidity::test::CommonOptions::get().evmVersion();
+	// Builds a root assembly with two sub-assemblies that share a common sub-assembly
+	// containing two identical blocks and a constant expression.
+	auto build = [&]() {
+		auto leaf = make_shared<Assembly>(evmVersion, false, "");
+		AssemblyItem first = leaf->newTag();
+		AssemblyItem second = leaf->newTag();
+		leaf->append(u256(0));
+		leaf->append(Instruction::CALLDATALOAD);
+		leaf->appendJumpI(first);
+		leaf->appendJump(second);
+		for (AssemblyItem const& tag: {first, second})
+		{
+			leaf->append(tag);
+			leaf->append(u256(1));
+			leaf->append(u256(2));
+			leaf->append(Instruction::ADD);
+			leaf->append(u256(0));
+			leaf->append(Instruction::SSTORE);
+			leaf->append(Instruction::STOP);
+		}
+
+		auto root = make_shared<Assembly>(evmVersion, true, "");
+		for (size_t i = 0; i < 2; ++i)
+		{
+			auto middle = make_shared<Assembly>(evmVersion, false, "");
+			AssemblyItem leafSub = middle->appendSubroutine(leaf);
+			middle->append(second.pushTag().toSubAssemblyTag(static_cast<size_t>(leafSub.data())));
+			middle->append(u256(i));
+			middle->append(Instruction::SSTORE);
+			middle->append(Instruction::STOP);
+			root->appendSubroutine(middle);
+		}
+		root->append(Instruction::STOP);
+		return root;
+	};
+
+	auto settings = Assembly::OptimiserSettings::translateSettings(OptimiserSettings::full(), evmVersion);
+	shared_ptr<Assembly> sequential = build();
+	sequential->optimise(settings);
+
+	settings.jobs = 4;
+	shared_ptr<Assembly> parallel = build();
+	parallel->optimise(settings);
+
+	BOOST_CHECK_EQUAL(parallel->assemblyString(), sequential->assemblyString());
+	BOOST_CHECK_EQUAL(parallel->assemble().toHex(), sequential->assemble().toHex());
+}
+
+BOOST_AUTO_TEST_CASE(assembly_item_data)
+{
+	u256 const small = u256(0xffffffffffffffffULL);
+	u256 const large = small + 1;
+	AssemblyItem smallPush(small);
+	AssemblyItem largePush(large);
+	BOOST_CHECK_EQUAL(smallPush.data(), small);
+	BOOST_CHECK_EQUAL(largePush.data(), large);
+	BOOST_CHECK(smallPush != largePush);
+	BOOST_CHECK(smallPush < largePush);
+	BOOST_CHECK(!(largePush < smallPush));
+	BOOST_CHECK(largePush == AssemblyItem(large));
+	BOOST_CHECK(!(largePush < AssemblyItem(large)));
+	BOOST_CHECK(AssemblyItem(large + 1) != largePush);
+	BOOST_CHECK(largePush < AssemblyItem(large + 1));
+
+	AssemblyItem copy = largePush;
+	copy.setData(small);
+	BOOST_CHECK(copy == smallPush);
+	BOOST_CHECK_EQUAL(largePush.data(), large);
+	copy.setData(large);
+	BOOST_CHECK(copy == largePush);
+
+	AssemblyItem foreignTag = AssemblyItem(PushTag, 7).toSubAssemblyTag(2);
+	BOOST_CHECK(foreignTag.splitForeignPushTag() == make_pair(size_t(2), size_t(7)));
+	BOOST_CHECK(foreignTag != AssemblyItem(PushTag, 7));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -20,7 +20,10 @@
  * Unit tests for libsolc/libsolc.cpp.
  */
 
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <boost/test/unit_test.hpp>
 #include <libsolutil/JSON.h>
 #include <libsolidity/interface/ReadFile.h>
@@ -179,6 +182,117 @@ BOOST_AUTO_TEST_CASE(with_callback)
 	BOOST_CHECK(containsError(result, "ParserError", "Source \"notfound.sol\" not found: Callback not supported."));
 }
 
+BOOST_AUTO_TEST_CASE(concurrent_contexts)
+{
+	string const sources = R"(
+		"fileA": {
+			"content": "// SPDX-License-Identifier: GPL-3.0\npragma solidity >=0.0;\nimport \"lib.sol\";\ncontract A { using L for uint; mapping(uint => bytes) m; function f(uint x, string calldata s) public returns (uint, bytes32) { m[x] = bytes(s); return (x.twice(), keccak256(m[x])); } }\ncontract B is A { event E(uint); function g() public { emit E(f(7, \"abc\").twice()); } }"
+		}
+	)";
+	vector<string> inputs;
+	for (char const* settings: {
+		R"({"outputSelection": {"*": {"*": ["abi", "metadata", "evm.bytecode.object"]}}})",
+		R"({"optimizer": {"enabled": true}, "outputSelection": {"*": {"*": ["evm.bytecode.object", "evm.deployedBytecode.object"]}}})",
+		R"({"viaIR": true, "optimizer": {"enabled": true}, "outputSelection": {"*": {"*": ["irOptimized", "evm.bytecode.object"]}}})"
+	})
+		inputs.push_back(R"({"language": "Solidity", "sources": {)" + sources + R"(}, "settings": )" + settings + "}");
+
+	size_t const threadCount = 8;
+	size_t const rounds = 3;
+
+	// Every compilation requests "lib.sol" once. If a barrier is passed as the read context,
+	// the compilations of all threads wait for each other there, so that their analysis and
+	// code generation overlap.
+	struct Barrier
+	{
+		explicit Barrier(size_t _threadCount): threadCount(_threadCount) {}
+
+		void arriveAndWait()
+		{
+			unique_lock<std::mutex> lock(mutex);
+			size_t const currentGeneration = generation;
+			if (++arrived == threadCount)
+			{
+				arrived = 0;
+				++generation;
+				condition.notify_all();
+			}
+			else
+				condition.wait(lock, [&]() { return generation != currentGeneration; });
+		}
+
+		size_t const threadCount;
+		std::mutex mutex;
+		condition_variable condition;
+		size_t arrived = 0;
+		size_t generation = 0;
+	};
+	Barrier barrier{threadCount};
+
+	// Does not use any Boost.Test macros, because they are not thread-safe.
+	CStyleReadFileCallback callback{
+		[](void* _context, char const*, char const* _path, char** o_contents, char** o_error)
+		{
+			*o_contents = nullptr;
+			*o_error = nullptr;
+			if (string(_path) == "lib.sol")
+			{
+				if (_context)
+					static_cast<Barrier*>(_context)->arriveAndWait();
+				string const content{"library L { function twice(uint x) internal pure returns (uint) { return 2 * x; } }"};
+				*o_contents = solidity_alloc(content.size());
+				if (*o_contents)
+					std::memcpy(*o_contents, content.data(), content.size());
+			}
+		}
+	};
+
+	vector<string> expectations;
+	solidity_context* context = solidity_create_context();
+	BOOST_REQUIRE(context);
+	for (string const& input: inputs)
+		expectations.emplace_back(solidity_compile_with_context(context, input.c_str(), callback, nullptr));
+	solidity_free_context(context);
+	for (string const& expectation: expectations)
+	{
+		Json::Value output;
+		BOOST_REQUIRE(util::jsonParseStrict(expectation, output));
+		BOOST_REQUIRE(output["contracts"]["fileA"]["B"]["evm"]["bytecode"]["object"].isString());
+		BOOST_CHECK(!output.isMember("errors"));
+	}
+
+	// Contexts are created up front, so that every thread takes part in each barrier.
+	vector<solidity_context*> contexts;
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		contexts.push_back(solidity_create_context());
+		BOOST_REQUIRE(contexts.back());
+	}
+	vector<vector<string>> results(threadCount);
+	vector<thread> threads;
+	for (size_t i = 0; i < threadCount; ++i)
+		threads.emplace_back([&, i]() {
+			for (size_t round = 0; round < rounds; ++round)
+				for (size_t j = 0; j < inputs.size(); ++j)
+				{
+					// Vary the order between threads, so that different kinds of compilations overlap.
+					string const& input = inputs[(i + j) % inputs.size()];
+					results[i].emplace_back(solidity_compile_with_context(contexts[i], input.c_str(), callback, &barrier));
+				}
+			solidity_free_context(contexts[i]);
+		});
+	for (thread& t: threads)
+		t.join();
+
+	for (size_t i = 0; i < threadCount; ++i)
+	{
+		BOOST_REQUIRE_EQUAL(results[i].size(), rounds * inputs.size());
+		for (size_t j = 0; j < results[i].size(); ++j)
+			BOOST_CHECK(results[i][j] == expectations[(i + j) % inputs.size()]);
+	}
+	solidity_reset();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
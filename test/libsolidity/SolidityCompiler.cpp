@@ -22,6 +22,8 @@
 #include <test/Metadata.h>
 #include <test/Common.h>
 
+#include <libsolidity/interface/CompilerStack.h>
+
 #include <boost/test/unit_test.hpp>
 
 using namespace std;
@@ -53,6 +55,69 @@ BOOST_AUTO_TEST_CASE(does_not_include_creation_time_only_internal_functions)
 	BOOST_CHECK(runtimeBytecode.size() <= 30);
 }
 
+BOOST_AUTO_TEST_CASE(code_generation_after_reusing_analysis)
+{
+	string const sourceCode = R"(
+		// SPDX-License-Identifier: GPL-3.0
+		pragma solidity >=0.0;
+		contract C {
+			function f(uint a) public pure returns (uint) {
+				require(a > 1, "too small");
+				return a * 3;
+			}
+		}
+	)";
+	struct Settings
+	{
+		size_t runs;
+		RevertStrings revertStrings;
+		bool viaIR;
+		CompilerStack::MetadataHash metadataHash;
+	};
+	vector<Settings> const variants{
+		{200, RevertStrings::Default, false, CompilerStack::MetadataHash::IPFS},
+		{1, RevertStrings::Strip, false, CompilerStack::MetadataHash::None},
+		{10000, RevertStrings::Default, true, CompilerStack::MetadataHash::Bzzr1},
+		{200, RevertStrings::Strip, true, CompilerStack::MetadataHash::IPFS},
+	};
+	auto configure = [](CompilerStack& _compilerStack, Settings const& _settings) {
+		OptimiserSettings optimiserSettings = OptimiserSettings::standard();
+		optimiserSettings.expectedExecutionsPerDeployment = _settings.runs;
+		_compilerStack.setOptimiserSettings(optimiserSettings);
+		_compilerStack.setRevertStringBehaviour(_settings.revertStrings);
+		_compilerStack.setViaIR(_settings.viaIR);
+		_compilerStack.setMetadataHash(_settings.metadataHash);
+	};
+
+	CompilerStack reusedStack;
+	reusedStack.setSources({{"C.sol", sourceCode}});
+	reusedStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+	reusedStack.setOptimiserSettings(OptimiserSettings::standard());
+	BOOST_REQUIRE(reusedStack.parseAndAnalyze());
+	BOOST_CHECK_THROW(reusedStack.setEVMVersion(langutil::EVMVersion{}), langutil::CompilerError);
+	BOOST_CHECK_THROW(reusedStack.setOptimiserSettings(OptimiserSettings::minimal()), langutil::CompilerError);
+
+	for (Settings const& settings: variants)
+	{
+		if (reusedStack.compilationSuccessful())
+			reusedStack.resetCodeGeneration();
+		configure(reusedStack, settings);
+		BOOST_REQUIRE(reusedStack.compile());
+
+		CompilerStack freshStack;
+		freshStack.setSources({{"C.sol", sourceCode}});
+		freshStack.setEVMVersion(solidity::test::CommonOptions::get().evmVersion());
+		configure(freshStack, settings);
+		BOOST_REQUIRE(freshStack.compile());
+
+		BOOST_CHECK(reusedStack.object("C").bytecode == freshStack.object("C").bytecode);
+		BOOST_CHECK(reusedStack.runtimeObject("C").bytecode == freshStack.runtimeObject("C").bytecode);
+		BOOST_CHECK_EQUAL(reusedStack.metadata("C"), freshStack.metadata("C"));
+		BOOST_CHECK_EQUAL(reusedStack.errors().size(), freshStack.errors().size());
+	}
+	BOOST_CHECK_THROW(configure(reusedStack, variants.front()), langutil::CompilerError);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -24,9 +24,12 @@
 #include <libsolidity/ast/Types.h>
 #include <libsolidity/ast/TypeProvider.h>
 #include <libsolidity/ast/AST.h>
+#include <libsolidity/interface/CompilerStack.h>
 #include <libsolutil/Keccak256.h>
 #include <boost/test/unit_test.hpp>
 
+#include <thread>
+
 using namespace std;
 using namespace solidity::langutil;
 
@@ -283,6 +286,58 @@ BOOST_AUTO_TEST_CASE(helper_string_result)
 	BOOST_REQUIRE_EQUAL(r1.message(), "Failure");
 }
 
+BOOST_AUTO_TEST_CASE(type_provider_scope)
+{
+	IntegerType const* defaultUint = TypeProvider::uint256();
+	TypeProvider first;
+	TypeProvider second;
+	{
+		TypeProvider::Scope firstScope{first};
+		IntegerType const* firstUint = TypeProvider::uint256();
+		BOOST_CHECK(firstUint != defaultUint);
+		{
+			TypeProvider::Scope secondScope{second};
+			BOOST_CHECK(TypeProvider::uint256() != firstUint);
+			BOOST_CHECK(TypeProvider::bytesMemory() != nullptr);
+		}
+		BOOST_CHECK(TypeProvider::uint256() == firstUint);
+	}
+	BOOST_CHECK(TypeProvider::uint256() == defaultUint);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_compiler_stacks)
+{
+	string const sourceCode = R"(
+		contract C {
+			struct S { uint[] a; bytes b; }
+			mapping(address => S) s;
+			function f(string memory _x, uint8 _y) public returns (bytes32, S memory) {
+				s[msg.sender].b = bytes(_x);
+				return (keccak256(abi.encode(_x, _y)), s[msg.sender]);
+			}
+		}
+	)";
+	auto compile = [&]() {
+		CompilerStack compilerStack;
+		compilerStack.setSources({{"A.sol", "pragma solidity >=0.0;\n" + sourceCode}});
+		if (!compilerStack.compile())
+			return string{};
+		return compilerStack.metadata("C") + util::toHex(compilerStack.object("C").bytecode);
+	};
+
+	string const expectation = compile();
+	BOOST_REQUIRE(!expectation.empty());
+
+	vector<string> results(4);
+	vector<thread> threads;
+	for (size_t i = 0; i < results.size(); ++i)
+		threads.emplace_back([&, i]() { results[i] = compile(); });
+	for (thread& t: threads)
+		t.join();
+	for (string const& result: results)
+		BOOST_CHECK_EQUAL(result, expectation);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
@@ -27,10 +27,15 @@
 #include <libsolidity/interface/Version.h>
 #include <libsolutil/JSON.h>
 #include <libsolutil/CommonData.h>
+#include <libsolutil/Keccak256.h>
+#include <libsolutil/TemporaryDirectory.h>
+#include <libyul/YulStack.h>
+#include <liblangutil/DebugInfoSelection.h>
 #include <test/Metadata.h>
 
 #include <algorithm>
 #include <set>
+#include <sstream>
 
 using namespace std;
 using namespace solidity::evmasm;
@@ -1818,6 +1823,517 @@ BOOST_AUTO_TEST_CASE(source_location_of_bare_block)
 	BOOST_REQUIRE(sourceMap.find(sourceRef) != string::npos);
 }
 
+BOOST_AUTO_TEST_CASE(jobs_invalid_value)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources":
+		{ "": { "content": "pragma solidity >=0.0; contract C { function f() public pure {} }" } },
+		"settings":
+		{
+			"jobs": 0
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.jobs\" must be a positive integer."));
+}
+
+BOOST_AUTO_TEST_CASE(parallel_jobs_output_identical_to_sequential)
+{
+	string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "pragma solidity >=0.0; contract A { uint x; function f(uint a) public returns (uint) { x += a; return x * 2; } }"
+			},
+			"B.sol": {
+				"content": "pragma solidity >=0.0; import \"A.sol\"; contract B { function g() public returns (address) { return address(new A()); } }"
+			},
+			"C.sol": {
+				"content": "pragma solidity >=0.0; import \"B.sol\"; contract C is B { function h(bytes calldata b) external pure returns (bytes32) { return keccak256(b); } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"jobs": JOBS,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": ["evm.bytecode", "evm.deployedBytecode", "evm.assembly", "irOptimized"] }
+			}
+		}
+	}
+	)";
+
+	auto compileWithJobs = [&](unsigned _jobs) {
+		string input = inputTemplate;
+		input.replace(input.find("JOBS"), 4, to_string(_jobs));
+		return StandardCompiler{}.compile(input);
+	};
+
+	string sequentialOutput = compileWithJobs(1);
+	Json::Value sequentialResult;
+	BOOST_REQUIRE(util::jsonParseStrict(sequentialOutput, sequentialResult));
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(getContractResult(sequentialResult, "C.sol", "C").isObject());
+
+	for (unsigned jobs: {2u, 4u})
+		BOOST_CHECK(compileWithJobs(jobs) == sequentialOutput);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_function_optimisation_output_identical_to_sequential)
+{
+	// A single contract leaves all threads to the optimisation of its functions. It has to be
+	// large enough for the optimiser steps to actually use them.
+	string functions;
+	for (size_t i = 0; i < 40; ++i)
+		functions +=
+			"function f" + to_string(i) + "(uint n) public returns (uint s) { " +
+			"for (uint i = 0; i < n; i++) { a.push(i * " + to_string(i) + "); s += m[i + n]; } } ";
+	string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "pragma solidity >=0.0; contract A { uint[] a; mapping(uint => uint) m; FUNCTIONS function g(bytes calldata b) external pure returns (bytes32, uint) { return (keccak256(b), b.length * 3); } function h(uint x, uint y) public view returns (uint) { if (x > y) return a[x - y] + m[x]; return x + y; } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"jobs": JOBS,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": ["evm.bytecode", "evm.deployedBytecode", "irOptimized"] }
+			}
+		}
+	}
+	)";
+
+	auto compileWithJobs = [&](unsigned _jobs) {
+		string input = inputTemplate;
+		input.replace(input.find("FUNCTIONS"), 9, functions);
+		input.replace(input.find("JOBS"), 4, to_string(_jobs));
+		return StandardCompiler{}.compile(input);
+	};
+
+	string sequentialOutput = compileWithJobs(1);
+	Json::Value sequentialResult;
+	BOOST_REQUIRE(util::jsonParseStrict(sequentialOutput, sequentialResult));
+	BOOST_REQUIRE(containsAtMostWarnings(sequentialResult));
+	BOOST_REQUIRE(getContractResult(sequentialResult, "A.sol", "A").isObject());
+
+	for (unsigned jobs: {2u, 8u})
+		BOOST_CHECK(compileWithJobs(jobs) == sequentialOutput);
+}
+
+BOOST_AUTO_TEST_CASE(ir_optimized_ast_of_factory)
+{
+	// The IR of contracts that create other contracts is not parsed as a whole, but the locations
+	// in its optimized AST have to be the same as if it was.
+	string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "pragma solidity >=0.0; contract A { uint x; function f(uint a) public returns (uint) { x += a; return x * 2; } }"
+			},
+			"B.sol": {
+				"content": "pragma solidity >=0.0; import \"A.sol\"; contract B { A a = new A(); function g() public returns (address) { return address(new A()); } }"
+			},
+			"C.sol": {
+				"content": "pragma solidity >=0.0; import \"B.sol\"; contract C { B b = new B(); function h(uint n) public returns (address r) { for (uint i = 0; i < n; i++) r = address(new A()); } function k() public returns (address) { return address(new B()); } }"
+			}
+		},
+		"settings": {
+			"viaIR": true,
+			"jobs": JOBS,
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": ["ir", "irOptimizedAst"] }
+			}
+		}
+	}
+	)";
+
+	for (unsigned jobs: {1u, 2u})
+	{
+		string input = inputTemplate;
+		input.replace(input.find("JOBS"), 4, to_string(jobs));
+		Json::Value result = compile(input);
+		BOOST_REQUIRE(containsAtMostWarnings(result));
+
+		for (auto const& [file, name]: vector<pair<string, string>>{{"A.sol", "A"}, {"B.sol", "B"}, {"C.sol", "C"}})
+		{
+			Json::Value contract = getContractResult(result, file, name);
+			BOOST_REQUIRE(contract["ir"].isString());
+
+			yul::YulStack stack(
+				langutil::EVMVersion{},
+				nullopt,
+				yul::YulStack::Language::StrictAssembly,
+				OptimiserSettings::standard(),
+				langutil::DebugInfoSelection::Default()
+			);
+			BOOST_REQUIRE(stack.parseAndAnalyze("", contract["ir"].asString()));
+			stack.optimize();
+			BOOST_CHECK_EQUAL(util::jsonCompactPrint(contract["irOptimizedAst"]), util::jsonCompactPrint(stack.astJson()));
+		}
+	}
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache)
+{
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "pragma solidity >=0.0; import \"lib.sol\"; contract A is L {}"
+			}
+		},
+		"settings": {
+			"outputSelection": {
+				"*": { "*": ["evm.bytecode.object"] }
+			}
+		}
+	}
+	)";
+	string libraryContent = "pragma solidity >=0.0; contract L { function f() public pure returns (uint) { return 1; } }";
+	size_t reads = 0;
+	ReadCallback::Callback readFile = [&](string const& _kind, string const& _path) {
+		BOOST_REQUIRE(_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile));
+		BOOST_REQUIRE(_path == "lib.sol");
+		++reads;
+		return ReadCallback::Result{true, libraryContent};
+	};
+
+	util::TemporaryDirectory cacheDirectory("solc-cache-test");
+	auto cache = make_shared<CompilationCache>(cacheDirectory.path(), 1024 * 1024);
+	auto compileCached = [&]() {
+		StandardCompiler compiler(readFile);
+		compiler.setCache(cache);
+		return compiler.compile(input);
+	};
+
+	string const output = compileCached();
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(output, result));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK_EQUAL(cache->statistics().misses, 1u);
+	BOOST_CHECK_EQUAL(cache->statistics().hits, 0u);
+
+	// The imported file is read again to validate the cached output.
+	BOOST_CHECK(compileCached() == output);
+	BOOST_CHECK_EQUAL(cache->statistics().hits, 1u);
+	BOOST_CHECK_EQUAL(reads, 2u);
+
+	libraryContent = "pragma solidity >=0.0; contract L { function f() public pure returns (uint) { return 2; } }";
+	string const changedOutput = compileCached();
+	BOOST_CHECK(changedOutput != output);
+	BOOST_CHECK(changedOutput == StandardCompiler(readFile).compile(input));
+	BOOST_CHECK_EQUAL(cache->statistics().misses, 2u);
+
+	CompilationCache::Statistics persistent = CompilationCache(cacheDirectory.path(), 1024 * 1024).persistentStatistics();
+	BOOST_CHECK_EQUAL(persistent.hits, 1u);
+	BOOST_CHECK_EQUAL(persistent.misses, 2u);
+}
+
+BOOST_AUTO_TEST_CASE(compilation_cache_eviction)
+{
+	util::TemporaryDirectory cacheDirectory("solc-cache-test");
+	CompilationCache cache(cacheDirectory.path(), 250);
+	cache.store(util::keccak256("a"), string(100, 'a'));
+	cache.store(util::keccak256("b"), string(100, 'b'));
+	BOOST_CHECK(cache.load(util::keccak256("a")) == string(100, 'a'));
+	BOOST_CHECK(cache.load(util::keccak256("b")) == string(100, 'b'));
+	cache.store(util::keccak256("c"), string(100, 'c'));
+	BOOST_CHECK_EQUAL(cache.statistics().evictions, 1u);
+	BOOST_CHECK(cache.load(util::keccak256("c")) == string(100, 'c'));
+	// Values larger than the whole cache are not stored.
+	cache.store(util::keccak256("d"), string(300, 'd'));
+	BOOST_CHECK(!cache.load(util::keccak256("d")));
+}
+
+BOOST_AUTO_TEST_CASE(reuse_analysis)
+{
+	string const inputTemplate = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": {
+				"content": "pragma solidity >=0.0; import \"lib.sol\"; contract A is L { function g(uint a) public pure returns (uint) { return a * 3; } }"
+			}
+		},
+		"settings": {
+			"optimizer": { "enabled": true, "runs": RUNS },
+			"outputSelection": {
+				"*": { "*": ["OUTPUT"] }
+			}
+		}
+	}
+	)";
+	auto input = [&](string const& _runs, string const& _output) {
+		string result = inputTemplate;
+		result.replace(result.find("RUNS"), 4, _runs);
+		result.replace(result.find("OUTPUT"), 6, _output);
+		return result;
+	};
+	string libraryContent = "pragma solidity >=0.0; contract L { function f() public pure returns (uint) { return 1; } }";
+	ReadCallback::Callback readFile = [&](string const& _kind, string const& _path) {
+		BOOST_REQUIRE(_kind == ReadCallback::kindString(ReadCallback::Kind::ReadFile));
+		BOOST_REQUIRE(_path == "lib.sol");
+		return ReadCallback::Result{true, libraryContent};
+	};
+
+	StandardCompiler compiler(readFile);
+	compiler.setReuseAnalysis(true);
+	string const output = compiler.compile(input("200", "evm.bytecode.object"));
+	Json::Value result;
+	BOOST_REQUIRE(util::jsonParseStrict(output, result));
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	BOOST_CHECK_EQUAL(compiler.reusedAnalyses(), 0u);
+
+	// Different code generator settings and outputs only generate the code again, with the same
+	// result as a separate compilation.
+	for (auto const& [runs, outputs]: vector<pair<string, string>>{
+		{"1000", "evm.bytecode.object"},
+		{"200", "evm.assembly"},
+		{"1", "abi"}
+	})
+		BOOST_CHECK(compiler.compile(input(runs, outputs)) == StandardCompiler(readFile).compile(input(runs, outputs)));
+	BOOST_CHECK_EQUAL(compiler.reusedAnalyses(), 3u);
+
+	// A changed import is analyzed again.
+	libraryContent = "pragma solidity >=0.0; contract L { function f() public pure returns (uint) { return 2; } }";
+	string const changedOutput = compiler.compile(input("200", "evm.bytecode.object"));
+	BOOST_CHECK(changedOutput != output);
+	BOOST_CHECK(changedOutput == StandardCompiler(readFile).compile(input("200", "evm.bytecode.object")));
+	BOOST_CHECK_EQUAL(compiler.reusedAnalyses(), 3u);
+
+	// Inputs failing the analysis are not kept.
+	libraryContent = "pragma solidity >=0.0; contract L { function f() public pure returns (uint) { return x; } }";
+	for (string const& runs: {"200", "1000"})
+	{
+		Json::Value failedResult;
+		BOOST_REQUIRE(util::jsonParseStrict(compiler.compile(input(runs, "abi")), failedResult));
+		BOOST_CHECK(!containsAtMostWarnings(failedResult));
+	}
+	BOOST_CHECK_EQUAL(compiler.reusedAnalyses(), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(streamed_output)
+{
+	// "a.sol:B" sorts before "a:A", but the source "a" comes first in the output.
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"a": { "content": "pragma solidity >=0.0; contract A { function f() public {} } contract Z {}" },
+			"a.sol": { "content": "pragma solidity >=0.0; contract B {}" },
+			"b.sol": { "content": "pragma solidity >=0.0; contract C { function g() public { uint x; } }" }
+		},
+		"settings": {
+			"outputSelection": {
+				"*": { "*": ["abi", "evm.bytecode.object"], "": ["ast"] }
+			}
+		}
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+
+	for (util::JsonFormat const& format: {util::JsonFormat{util::JsonFormat::Compact}, util::JsonFormat{util::JsonFormat::Pretty}})
+	{
+		Json::Value const expectedOutput = StandardCompiler().compile(parsedInput);
+		BOOST_REQUIRE(containsAtMostWarnings(expectedOutput));
+		BOOST_REQUIRE(expectedOutput["errors"].size() > 0);
+		BOOST_REQUIRE(getContractResult(expectedOutput, "a.sol", "B").isObject());
+		BOOST_CHECK_EQUAL(StandardCompiler(ReadCallback::Callback(), format).compile(input), util::jsonPrint(expectedOutput, format));
+		ostringstream streamedOutput;
+		StandardCompiler(ReadCallback::Callback(), format).compile(input, streamedOutput);
+		BOOST_CHECK_EQUAL(streamedOutput.str(), util::jsonPrint(expectedOutput, format));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(settings_variants)
+{
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "pragma solidity >=0.0; contract A { function f(uint a) public pure returns (uint) { uint b; return a * 2; } }" },
+			"B.sol": { "content": "pragma solidity >=0.0; import \"A.sol\"; contract B { function g() public returns (address) { return address(new A()); } }" }
+		},
+		"settings": {
+			"outputSelection": {
+				"*": { "*": ["metadata", "evm.bytecode.object", "evm.assembly"], "": ["ast"] }
+			}
+		},
+		"settingsVariants": [
+			{},
+			{ "optimizer": { "enabled": true, "runs": 1000 } },
+			{ "evmVersion": "london" },
+			{ "optimizer": { "enabled": true, "runs": 1 }, "evmVersion": "london" },
+			{ "evmVersion": "invalid" }
+		]
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+	Json::Value const result = StandardCompiler().compile(parsedInput);
+	BOOST_REQUIRE(result["variants"].isArray());
+	BOOST_REQUIRE_EQUAL(result["variants"].size(), parsedInput["settingsVariants"].size());
+
+	// Every variant produces the same output as a separate compilation with the merged settings.
+	Json::Value singleInput = parsedInput;
+	singleInput.removeMember("settingsVariants");
+	for (Json::ArrayIndex index = 0; index < result["variants"].size(); ++index)
+	{
+		Json::Value variantInput = singleInput;
+		for (string const& key: parsedInput["settingsVariants"][index].getMemberNames())
+			variantInput["settings"][key] = parsedInput["settingsVariants"][index][key];
+		BOOST_CHECK(result["variants"][index] == StandardCompiler().compile(variantInput));
+	}
+
+	for (Json::ArrayIndex index = 0; index < 4; ++index)
+	{
+		BOOST_CHECK(containsAtMostWarnings(result["variants"][index]));
+		BOOST_CHECK(getContractResult(result["variants"][index], "B.sol", "B").isObject());
+	}
+	BOOST_CHECK(
+		getContractResult(result["variants"][0], "B.sol", "B")["evm"]["bytecode"]["object"] !=
+		getContractResult(result["variants"][1], "B.sol", "B")["evm"]["bytecode"]["object"]
+	);
+	BOOST_CHECK(containsError(result["variants"][4], "JSONError", "Invalid EVM version requested."));
+}
+
+BOOST_AUTO_TEST_CASE(settings_variants_shared_analysis)
+{
+	// The first two variants select different sources, so they cannot share the analysis with any
+	// other variant. The last three only differ in settings used by the code generator, so they do.
+	string const input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "pragma solidity >=0.0; contract A { function f(uint a) public pure returns (uint) { return a * 0x1234567890; } }" },
+			"B.sol": { "content": "pragma solidity >=0.0; import \"A.sol\"; contract B { function g() public returns (address) { return address(new A()); } }" },
+			"C.sol": { "content": "pragma solidity >=0.0; contract C { function h() public pure returns (uint) { return 0x1234567890 * 0x1234567890; } }" }
+		},
+		"settings": {
+			"optimizer": { "enabled": true },
+			"outputSelection": {
+				"*": { "*": ["metadata", "evm.bytecode.object", "evm.assembly"], "": ["ast"] }
+			}
+		},
+		"settingsVariants": [
+			{ "outputSelection": { "B.sol": { "*": ["evm.bytecode.object"] } } },
+			{ "outputSelection": { "C.sol": { "*": ["evm.bytecode.object"] } } },
+			{ "optimizer": { "enabled": true, "runs": 1 } },
+			{ "optimizer": { "enabled": true, "runs": 1000000 } },
+			{ "optimizer": { "enabled": true, "runs": 1000000 }, "viaIR": true }
+		]
+	}
+	)";
+	Json::Value parsedInput;
+	BOOST_REQUIRE(util::jsonParseStrict(input, parsedInput));
+	Json::Value const result = StandardCompiler().compile(parsedInput);
+	BOOST_REQUIRE(result["variants"].isArray());
+	BOOST_REQUIRE_EQUAL(result["variants"].size(), parsedInput["settingsVariants"].size());
+
+	Json::Value singleInput = parsedInput;
+	singleInput.removeMember("settingsVariants");
+	for (Json::ArrayIndex index = 0; index < result["variants"].size(); ++index)
+	{
+		Json::Value variantInput = singleInput;
+		for (string const& key: parsedInput["settingsVariants"][index].getMemberNames())
+			variantInput["settings"][key] = parsedInput["settingsVariants"][index][key];
+		BOOST_CHECK(containsAtMostWarnings(result["variants"][index]));
+		BOOST_CHECK(result["variants"][index] == StandardCompiler().compile(variantInput));
+	}
+
+	BOOST_CHECK(getContractResult(result["variants"][0], "B.sol", "B").isObject());
+	BOOST_CHECK(!getContractResult(result["variants"][0], "C.sol", "C").isObject());
+	BOOST_CHECK(getContractResult(result["variants"][1], "C.sol", "C").isObject());
+	for (Json::ArrayIndex index = 2; index < 5; ++index)
+		for (auto const& [sourceName, contractName]: vector<pair<string, string>>{{"A.sol", "A"}, {"B.sol", "B"}, {"C.sol", "C"}})
+			BOOST_CHECK(getContractResult(result["variants"][index], sourceName, contractName).isObject());
+	BOOST_CHECK(
+		getContractResult(result["variants"][2], "A.sol", "A")["evm"]["bytecode"]["object"] !=
+		getContractResult(result["variants"][3], "A.sol", "A")["evm"]["bytecode"]["object"]
+	);
+}
+
+BOOST_AUTO_TEST_CASE(settings_variants_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A {}" } },
+		"settingsVariants": {}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settingsVariants\" must be a non-empty array."));
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_profile)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": {
+			"A.sol": { "content": "pragma solidity >=0.0; contract A { function f(uint a) public pure returns (uint) { return a * 2 + 1; } }" }
+		},
+		"settings": {
+			"viaIR": true,
+			"optimizer": { "enabled": true },
+			"optimizerProfile": true,
+			"outputSelection": { "*": { "*": ["evm.bytecode.object"] } }
+		}
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_REQUIRE(containsAtMostWarnings(result));
+	Json::Value const& profile = getContractResult(result, "A.sol", "A")["optimizerProfile"];
+	BOOST_REQUIRE(profile.isObject());
+	BOOST_REQUIRE(profile["steps"].isObject());
+	BOOST_CHECK(profile["totalDurationMicroseconds"].isInt64());
+	for (string const& step: {"ExpressionSimplifier"s, "FunctionHoister"s, "UnusedPruner"s})
+	{
+		Json::Value const& metrics = profile["steps"][step];
+		BOOST_REQUIRE_MESSAGE(metrics.isObject(), step);
+		BOOST_CHECK(metrics["invocations"].asUInt64() > 0);
+		BOOST_CHECK(metrics["durationMicroseconds"].isInt64());
+		BOOST_CHECK(metrics["nodesBefore"].asUInt64() > 0);
+		BOOST_CHECK(metrics["nodesAfter"].asUInt64() > 0);
+	}
+
+	Json::Value withoutProfile;
+	BOOST_REQUIRE(util::jsonParseStrict(input, withoutProfile));
+	withoutProfile["settings"].removeMember("optimizerProfile");
+	Json::Value resultWithoutProfile = StandardCompiler().compile(withoutProfile);
+	BOOST_CHECK(!getContractResult(resultWithoutProfile, "A.sol", "A").isMember("optimizerProfile"));
+	BOOST_CHECK(
+		getContractResult(resultWithoutProfile, "A.sol", "A")["evm"] ==
+		getContractResult(result, "A.sol", "A")["evm"]
+	);
+}
+
+BOOST_AUTO_TEST_CASE(optimizer_profile_invalid)
+{
+	char const* input = R"(
+	{
+		"language": "Solidity",
+		"sources": { "A.sol": { "content": "contract A {}" } },
+		"settings": { "optimizerProfile": 1 }
+	}
+	)";
+	Json::Value result = compile(input);
+	BOOST_CHECK(containsError(result, "JSONError", "\"settings.optimizerProfile\" must be a Boolean."));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
@@ -21,11 +21,14 @@
  */
 
 #include <libsolutil/JSON.h>
+#include <libsolutil/Exceptions.h>
 
 #include <test/Common.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <sstream>
+
 using namespace std;
 
 namespace solidity::util::test
@@ -118,6 +121,52 @@ BOOST_AUTO_TEST_CASE(json_compact_print)
 	BOOST_CHECK("{\"1\":1,\"2\":\"2\",\"3\":{\"3.1\":\"3.1\",\"3.2\":2},\"4\":\"\\u0911 \\u0912 \\u0913 \\u0914 \\u0915 \\u0916\",\"5\":\"\\ufffd\"}" == jsonCompactPrint(json));
 }
 
+BOOST_AUTO_TEST_CASE(json_object_stream_writer)
+{
+	Json::Value child;
+	child["3.1"] = "3.1";
+	child["3.2"] = Json::arrayValue;
+	child["3.2"].append(1);
+	child["3.2"].append(Json::objectValue);
+	child["3.2"][1]["a"] = "b";
+
+	Json::Value json;
+	json["1"] = 1;
+	json["2"]["2.1"] = Json::objectValue;
+	json["2"]["2.2"]["2.2.1"] = "ऑ";
+	json["3"] = child;
+	json["4"] = Json::objectValue;
+
+	for (JsonFormat const& format: {JsonFormat{JsonFormat::Compact}, JsonFormat{JsonFormat::Pretty}, JsonFormat{JsonFormat::Pretty, 4}})
+	{
+		ostringstream output;
+		output << "prefix";
+		JsonObjectStreamWriter writer(output, format);
+		writer.member("1", json["1"]);
+		writer.beginObject("2");
+		writer.beginObject("2.1");
+		writer.endObject();
+		writer.beginObject("2.2");
+		writer.member("2.2.1", json["2"]["2.2"]["2.2.1"]);
+		writer.endObject();
+		writer.endObject();
+		writer.member("3", child);
+		writer.beginObject("4");
+		writer.finish();
+		BOOST_CHECK_EQUAL(output.str(), "prefix" + jsonPrint(json, format));
+	}
+
+	ostringstream output;
+	JsonObjectStreamWriter writer(output, JsonFormat{JsonFormat::Pretty});
+	writer.finish();
+	BOOST_CHECK_EQUAL(output.str(), "{}");
+
+	JsonObjectStreamWriter unorderedWriter(output, JsonFormat{});
+	unorderedWriter.member("b", 1);
+	BOOST_CHECK_THROW(unorderedWriter.member("a", 1), Exception);
+	BOOST_CHECK_THROW(unorderedWriter.beginObject("b"), Exception);
+}
+
 BOOST_AUTO_TEST_CASE(parse_json_strict)
 {
 	// In this test we check conformance against JSON.parse (https://tc39.es/ecma262/multipage/structured-data.html#sec-json.parse)
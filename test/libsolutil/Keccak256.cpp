@@ -69,6 +69,57 @@ BOOST_AUTO_TEST_CASE(strings)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(block_boundaries)
+{
+	// Inputs around the rate of 136 bytes, i.e. where the padding needs an extra block.
+	BOOST_CHECK_EQUAL(
+		keccak256(bytes(135, 'a')),
+		FixedHash<32>("0x34367dc248bbd832f4e3e69dfaac2f92638bd0bbd18f2912ba4ef454919cf446")
+	);
+	BOOST_CHECK_EQUAL(
+		keccak256(bytes(136, 'a')),
+		FixedHash<32>("0xa6c4d403279fe3e0af03729caada8374b5ca54d8065329a3ebcaeb4b60aa386e")
+	);
+	BOOST_CHECK_EQUAL(
+		keccak256(bytes(137, 'a')),
+		FixedHash<32>("0xd869f639c7046b4929fc92a4d988a8b22c55fbadb802c0c66ebcd484f1915f39")
+	);
+	BOOST_CHECK_EQUAL(
+		keccak256(bytes(272, 'a')),
+		FixedHash<32>("0xcf7fcd4f705ee749930d19ca84561a9bf62516bd90a471545fa2f49fdc7e63c8")
+	);
+	BOOST_CHECK_EQUAL(
+		keccak256(bytes(1000, 'a')),
+		FixedHash<32>("0xb6a4ac1f51884d71f30fa397a5e155de3099e11fc0edef5d08b646e621e19de9")
+	);
+}
+
+BOOST_AUTO_TEST_CASE(multiple_inputs)
+{
+	BOOST_CHECK(keccak256(vector<bytesConstRef>{}).empty());
+
+	// Enough inputs of each length for groups of four, plus some that are left over.
+	vector<bytes> data;
+	for (size_t length: vector<size_t>{0, 1, 4, 31, 135, 136, 137, 500, 1000})
+		for (size_t i = 0; i < length % 7 + 1; ++i)
+			data.emplace_back(length, static_cast<uint8_t>(data.size()));
+	vector<bytesConstRef> inputs;
+	for (bytes const& input: data)
+		inputs.emplace_back(&input);
+
+	vector<h256> hashes = keccak256(inputs);
+	BOOST_REQUIRE_EQUAL(hashes.size(), inputs.size());
+	for (size_t i = 0; i < inputs.size(); ++i)
+		BOOST_CHECK_EQUAL(hashes[i], keccak256(inputs[i]));
+
+	string const test = "test";
+	string const longer = "longer test string";
+	BOOST_CHECK_EQUAL(
+		keccak256(vector<bytesConstRef>{bytesConstRef(test), bytesConstRef(longer)}).back(),
+		FixedHash<32>("0x47bed17bfbbc08d6b5a0f603eff1b3e932c37c10b865847a7bc73d55b260f32a")
+	);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 }
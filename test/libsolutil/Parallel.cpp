@@ -0,0 +1,72 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+
+#include <libsolutil/Parallel.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace solidity::util::test
+{
+
+BOOST_AUTO_TEST_SUITE(ParallelTest)
+
+BOOST_AUTO_TEST_CASE(worker_pool_runs_every_task_once)
+{
+	WorkerPool pool(4);
+	BOOST_CHECK_EQUAL(pool.jobs(), 4u);
+	for (size_t count: {0u, 1u, 3u, 4u, 100u})
+	{
+		vector<size_t> calls(count);
+		pool.run(count, [&](size_t _index) { ++calls[_index]; });
+		BOOST_CHECK(calls == vector<size_t>(count, 1));
+	}
+}
+
+BOOST_AUTO_TEST_CASE(worker_pool_keeps_threads)
+{
+	// Data kept per thread survives between runs, since no new threads are started.
+	mutex threadsMutex;
+	set<thread::id> threads;
+	WorkerPool pool(3);
+	for (size_t run = 0; run < 50; ++run)
+		pool.run(20, [&](size_t) {
+			lock_guard<mutex> lock(threadsMutex);
+			threads.insert(this_thread::get_id());
+		});
+	BOOST_CHECK_LE(threads.size(), pool.jobs());
+}
+
+BOOST_AUTO_TEST_CASE(worker_pool_without_threads)
+{
+	WorkerPool pool(1);
+	BOOST_CHECK_EQUAL(pool.jobs(), 1u);
+	vector<thread::id> threads;
+	pool.run(5, [&](size_t) { threads.push_back(this_thread::get_id()); });
+	BOOST_CHECK(threads == vector<thread::id>(5, this_thread::get_id()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
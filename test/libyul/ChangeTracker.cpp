@@ -0,0 +1,243 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the detection of changes between optimiser steps.
+ */
+
+#include <test/Common.h>
+
+#include <test/libyul/Common.h>
+
+#include <libyul/optimiser/ChangeTracker.h>
+#include <libyul/optimiser/Metrics.h>
+#include <libyul/optimiser/NameDispenser.h>
+#include <libyul/optimiser/OptimiserStep.h>
+#include <libyul/optimiser/OptimizerUtilities.h>
+#include <libyul/backends/evm/EVMDialect.h>
+#include <libyul/AST.h>
+#include <libyul/SideEffects.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+shared_ptr<Block> parseCode(string const& _source)
+{
+	shared_ptr<Block> ast = parse(_source, false).first;
+	BOOST_REQUIRE(ast);
+	return ast;
+}
+
+FunctionDefinition& function(Block& _ast, size_t _index)
+{
+	BOOST_REQUIRE(_index < _ast.statements.size());
+	BOOST_REQUIRE(holds_alternative<FunctionDefinition>(_ast.statements[_index]));
+	return std::get<FunctionDefinition>(_ast.statements[_index]);
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulChangeTracker)
+
+BOOST_AUTO_TEST_CASE(unchanged)
+{
+	shared_ptr<Block> ast = parseCode("{ f() function f() { sstore(0, 1) } }");
+	ChangeTracker tracker;
+	BOOST_CHECK(tracker.update(*ast));
+	size_t version = tracker.version();
+	BOOST_CHECK(!tracker.update(*ast));
+	BOOST_CHECK_EQUAL(tracker.version(), version);
+}
+
+BOOST_AUTO_TEST_CASE(changed_function)
+{
+	shared_ptr<Block> ast = parseCode("{ f() function f() { sstore(0, 1) } function g() {} }");
+	ChangeTracker tracker;
+	tracker.update(*ast);
+	size_t version = tracker.version();
+
+	function(*ast, 1).body.statements.clear();
+	BOOST_CHECK(tracker.update(*ast));
+	BOOST_CHECK_EQUAL(tracker.version(), version + 1);
+	BOOST_CHECK(!tracker.update(*ast));
+}
+
+BOOST_AUTO_TEST_CASE(renamed_variable)
+{
+	shared_ptr<Block> ast = parseCode("{ function f() -> x { x := 1 } }");
+	ChangeTracker tracker;
+	tracker.update(*ast);
+
+	function(*ast, 0).returnVariables.front().name = YulString{"y"};
+	BOOST_CHECK(tracker.update(*ast));
+}
+
+BOOST_AUTO_TEST_CASE(removed_and_reordered_functions)
+{
+	shared_ptr<Block> ast = parseCode("{ function f() {} function g() {} function h() {} }");
+	ChangeTracker tracker;
+	tracker.update(*ast);
+
+	swap(ast->statements[0], ast->statements[1]);
+	BOOST_CHECK(tracker.update(*ast));
+
+	ast->statements.pop_back();
+	BOOST_CHECK(tracker.update(*ast));
+	BOOST_CHECK(!tracker.update(*ast));
+}
+
+BOOST_AUTO_TEST_CASE(debug_data)
+{
+	shared_ptr<Block> ast = parseCode("{ function f() { sstore(0, 1) } }");
+	ChangeTracker tracker;
+	tracker.update(*ast);
+
+	// Copies of debug data do not change the fingerprint, different debug data does.
+	Statement& statement = function(*ast, 0).body.statements.front();
+	ExpressionStatement& expressionStatement = std::get<ExpressionStatement>(statement);
+	expressionStatement.debugData = make_shared<DebugData const>(*expressionStatement.debugData);
+	BOOST_CHECK(!tracker.update(*ast));
+
+	langutil::SourceLocation location = expressionStatement.debugData->nativeLocation;
+	location.end += 1;
+	expressionStatement.debugData = DebugData::create(location);
+	BOOST_CHECK(tracker.update(*ast));
+
+	expressionStatement.debugData = DebugData::create(location, {}, 42);
+	BOOST_CHECK(tracker.update(*ast));
+}
+
+BOOST_AUTO_TEST_CASE(code_size)
+{
+	shared_ptr<Block> ast = parseCode(R"({
+		f(1)
+		{ function h() { if 1 { } } }
+		function f(a) { sstore(a, add(a, 2)) }
+		function g() -> x { for {} 1 {} { x := mload(3) } }
+	})");
+	ChangeTracker tracker;
+	tracker.update(*ast);
+	BOOST_CHECK_EQUAL(tracker.codeSize(), CodeSize::codeSizeIncludingFunctions(*ast));
+
+	function(*ast, 3).body.statements.clear();
+	tracker.update(*ast);
+	BOOST_CHECK_EQUAL(tracker.codeSize(), CodeSize::codeSizeIncludingFunctions(*ast));
+}
+
+BOOST_AUTO_TEST_CASE(unchanged_parts)
+{
+	shared_ptr<Block> ast = parseCode("{ { f() } function f() { sstore(0, 1) } function g() {} }");
+	ChangeTracker tracker;
+	tracker.update(*ast);
+	UnchangedParts parts(tracker);
+	BOOST_CHECK(!parts.skip({}, 1));
+	BOOST_CHECK(!parts.skip(YulString{"f"}, 1));
+	BOOST_CHECK(!parts.skip(YulString{"g"}, 1));
+
+	// The step changed f.
+	function(*ast, 1).body.statements.clear();
+	tracker.update(*ast);
+	parts.update();
+	BOOST_CHECK(parts.skip({}, 1));
+	BOOST_CHECK(!parts.skip(YulString{"f"}, 1));
+	BOOST_CHECK(parts.skip(YulString{"g"}, 1));
+	BOOST_CHECK(!parts.skip(YulString{"g"}, 2));
+	tracker.update(*ast);
+	parts.update();
+	BOOST_CHECK(parts.skip(YulString{"f"}, 1));
+	BOOST_CHECK(!parts.skip(YulString{"g"}, 1));
+	BOOST_CHECK(parts.skip(YulString{"g"}, 2));
+
+	// Another step changed g.
+	function(*ast, 2).returnVariables.emplace_back(TypedName{DebugData::create(), YulString{"r"}, {}});
+	tracker.update(*ast);
+	BOOST_CHECK(!parts.skip(YulString{"g"}, 2));
+	BOOST_CHECK(!parts.skip(YulString{"h"}, 1));
+}
+
+BOOST_AUTO_TEST_CASE(transform_functions_skips_unchanged_parts)
+{
+	shared_ptr<Block> ast = parseCode("{ { f() g() } function f() { sstore(0, 1) } function g() { sstore(1, 2) } }");
+	EVMDialect const& dialect = EVMDialect::strictAssemblyForEVM(langutil::EVMVersion{});
+	NameDispenser dispenser{dialect, *ast};
+	set<YulString> reserved;
+	OptimiserStepContext context{dialect, dispenser, reserved, 0};
+	ChangeTracker tracker;
+	tracker.update(*ast);
+	UnchangedParts parts(tracker);
+	context.unchangedParts = &parts;
+
+	// Removes the body of f and records the transformed parts.
+	vector<string> transformed;
+	auto run = [&](uint64_t _dependencies) {
+		transformed.clear();
+		transformFunctions(
+			context,
+			*ast,
+			[&]() -> function<void(Block&)> {
+				return [&](Block& _part) {
+					for (Statement& statement: _part.statements)
+						if (FunctionDefinition* function = get_if<FunctionDefinition>(&statement))
+						{
+							transformed.emplace_back(function->name.str());
+							if (function->name == YulString{"f"})
+								function->body.statements.clear();
+						}
+						else
+							transformed.emplace_back("code");
+				};
+			},
+			_dependencies
+		);
+		tracker.update(*ast);
+		parts.update();
+	};
+
+	run(1);
+	BOOST_CHECK((transformed == vector<string>{"code", "f", "g"}));
+	BOOST_CHECK(function(*ast, 1).body.statements.empty());
+	run(1);
+	BOOST_CHECK((transformed == vector<string>{"f"}));
+	run(1);
+	BOOST_CHECK(transformed.empty());
+	run(2);
+	BOOST_CHECK((transformed == vector<string>{"code", "f", "g"}));
+	BOOST_REQUIRE_EQUAL(ast->statements.size(), 3);
+	BOOST_CHECK(holds_alternative<Block>(ast->statements[0]));
+	BOOST_CHECK(function(*ast, 2).name == YulString{"g"});
+}
+
+BOOST_AUTO_TEST_CASE(dependencies)
+{
+	map<YulString, SideEffects> sideEffects{{YulString{"f"}, SideEffects{}}};
+	uint64_t hash = DependencyHasher{}(sideEffects)(false).hash();
+	BOOST_CHECK_EQUAL(DependencyHasher{}(sideEffects)(false).hash(), hash);
+	BOOST_CHECK(DependencyHasher{}(sideEffects)(true).hash() != hash);
+	sideEffects[YulString{"f"}].storage = SideEffects::Write;
+	BOOST_CHECK(DependencyHasher{}(sideEffects)(false).hash() != hash);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -26,6 +26,8 @@
 #include <liblangutil/DebugInfoSelection.h>
 #include <liblangutil/Scanner.h>
 
+#include <libyul/AST.h>
+#include <libyul/Object.h>
 #include <libyul/YulStack.h>
 #include <libyul/backends/evm/EVMDialect.h>
 
@@ -191,6 +193,54 @@ BOOST_AUTO_TEST_CASE(to_string)
 	BOOST_CHECK_EQUAL(asmStack.print(), expectation);
 }
 
+BOOST_AUTO_TEST_CASE(analyze_combined_objects)
+{
+	string inner = R"(
+		object "i" {
+			code { sstore(0, datasize("i_deployed")) }
+			object "i_deployed" { code {} }
+		}
+	)";
+	string outer = R"(
+		object "O" {
+			code { sstore(0, datasize("i.i_deployed")) }
+			object "i" { code {} }
+			data "j" "abc"
+		}
+	)";
+	auto createStack = []() {
+		return make_unique<YulStack>(
+			solidity::test::CommonOptions::get().evmVersion(),
+			solidity::test::CommonOptions::get().eofVersion(),
+			YulStack::Language::StrictAssembly,
+			solidity::frontend::OptimiserSettings::none(),
+			DebugInfoSelection::All()
+		);
+	};
+
+	auto innerStack = createStack();
+	shared_ptr<Object const> innerObject = innerStack->parse("inner", inner);
+	BOOST_REQUIRE(innerObject);
+	auto outerStack = createStack();
+	shared_ptr<Object> outerObject = outerStack->parse("outer", outer);
+	BOOST_REQUIRE(outerObject);
+	// The placeholder alone does not contain the referenced object.
+	BOOST_CHECK(!createStack()->analyze(outerObject->clone()));
+
+	outerObject->subObjects.at(outerObject->subIndexByName.at(YulString{"i"})) = innerObject->clone();
+	BOOST_REQUIRE(outerStack->analyze(outerObject));
+
+	auto combinedStack = createStack();
+	BOOST_REQUIRE(combinedStack->parseAndAnalyze(
+		"combined",
+		boost::replace_all_copy(outer, "object \"i\" { code {} }", inner)
+	));
+	BOOST_CHECK_EQUAL(outerStack->print(), combinedStack->print());
+	// The inner object was copied and can be reused.
+	BOOST_CHECK(innerObject->code->statements.size() == 1);
+	BOOST_CHECK(outerObject->subObjects.at(0).get() != innerObject.get());
+}
+
 BOOST_AUTO_TEST_CASE(use_src_empty)
 {
 	auto const [mapping, _] = tryGetSourceLocationMapping("");
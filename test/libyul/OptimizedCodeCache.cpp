@@ -0,0 +1,137 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the reuse of optimized Yul objects.
+ */
+
+#include <test/Common.h>
+
+#include <liblangutil/DebugInfoSelection.h>
+
+#include <libyul/OptimizedCodeCache.h>
+#include <libyul/YulStack.h>
+
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <boost/test/unit_test.hpp>
+
+using namespace std;
+using namespace solidity::langutil;
+
+namespace solidity::yul::test
+{
+
+namespace
+{
+
+// The object "B" is created both by the constructor and by the runtime code of "A",
+// like a contract deployed by a factory, so it is contained twice.
+string const source = R"(
+object "A" {
+	code {
+		let size := datasize("B")
+		datacopy(0, dataoffset("B"), size)
+		sstore(0, create(0, 0, size))
+		datacopy(0, dataoffset("A_deployed"), datasize("A_deployed"))
+		return(0, datasize("A_deployed"))
+	}
+	object "A_deployed" {
+		code {
+			function deploy(salt) -> addr {
+				let size := datasize("B")
+				datacopy(0, dataoffset("B"), size)
+				addr := create2(0, 0, size, salt)
+				if iszero(addr) { revert(0, 0) }
+			}
+			sstore(1, deploy(calldataload(0)))
+		}
+		object "B" {
+			code {
+				sstore(0, add(calldataload(0), 1))
+				datacopy(0, dataoffset("B_deployed"), datasize("B_deployed"))
+				return(0, datasize("B_deployed"))
+			}
+			object "B_deployed" {
+				code {
+					function f(a, b) -> r { r := add(mul(a, b), sload(a)) }
+					sstore(f(calldataload(0), 2), f(calldataload(32), 3))
+				}
+			}
+		}
+	}
+	object "B" {
+		code {
+			sstore(0, add(calldataload(0), 1))
+			datacopy(0, dataoffset("B_deployed"), datasize("B_deployed"))
+			return(0, datasize("B_deployed"))
+		}
+		object "B_deployed" {
+			code {
+				function f(a, b) -> r { r := add(mul(a, b), sload(a)) }
+				sstore(f(calldataload(0), 2), f(calldataload(32), 3))
+			}
+		}
+	}
+}
+)";
+
+/// @returns the optimized code and the bytecode of the source.
+pair<string, bytes> compile(shared_ptr<OptimizedCodeCache> _cache)
+{
+	YulStack stack(
+		solidity::test::CommonOptions::get().evmVersion(),
+		solidity::test::CommonOptions::get().eofVersion(),
+		YulStack::Language::StrictAssembly,
+		solidity::frontend::OptimiserSettings::full(),
+		DebugInfoSelection::All(),
+		std::move(_cache)
+	);
+	BOOST_REQUIRE(stack.parseAndAnalyze("source", source));
+	stack.optimize();
+	MachineAssemblyObject object = stack.assemble(YulStack::Machine::EVM);
+	BOOST_REQUIRE(object.bytecode);
+	return {stack.print(), object.bytecode->bytecode};
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(YulOptimizedCodeCache)
+
+BOOST_AUTO_TEST_CASE(output_identical_to_uncached)
+{
+	auto const [uncachedCode, uncachedBytecode] = compile(nullptr);
+
+	auto cache = make_shared<OptimizedCodeCache>();
+	auto const [cachedCode, cachedBytecode] = compile(cache);
+	BOOST_CHECK_EQUAL(cachedCode, uncachedCode);
+	BOOST_CHECK(cachedBytecode == uncachedBytecode);
+
+	// The second copy of "B" and of "B_deployed" was found in the cache.
+	size_t const cacheSize = cache->size();
+	BOOST_CHECK_EQUAL(cacheSize, 4u);
+
+	// All objects are taken from the warm cache.
+	auto const [warmCode, warmBytecode] = compile(cache);
+	BOOST_CHECK_EQUAL(warmCode, uncachedCode);
+	BOOST_CHECK(warmBytecode == uncachedBytecode);
+	BOOST_CHECK_EQUAL(cache->size(), cacheSize);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
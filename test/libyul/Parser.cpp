@@ -951,6 +951,46 @@ BOOST_AUTO_TEST_CASE(customSourceLocations_multiple_src_tags_on_one_line)
 	CHECK_LOCATION(varX.debugData->originLocation, "source1", 4, 5);
 }
 
+BOOST_AUTO_TEST_CASE(location_override_shares_debug_data)
+{
+	ErrorList errorList;
+	ErrorReporter reporter(errorList);
+	CharStream stream("{ let x := add(1, 2) }", "");
+	SourceLocation const location{10, 20, make_shared<string const>("source0")};
+	unique_ptr<Block> result = Parser(reporter, EVMDialectTyped::instance(EVMVersion{}), location).parse(stream);
+	BOOST_REQUIRE(!!result && errorList.empty());
+	BOOST_REQUIRE_EQUAL(result->statements.size(), 1);
+
+	VariableDeclaration const& varX = get<VariableDeclaration>(result->statements.at(0));
+	BOOST_CHECK(varX.debugData == result->debugData);
+	BOOST_CHECK(get<FunctionCall>(*varX.value).debugData == result->debugData);
+	CHECK_LOCATION(result->debugData->nativeLocation, "source0", 10, 20);
+	CHECK_LOCATION(result->debugData->originLocation, "source0", 10, 20);
+
+	BOOST_CHECK(DebugData::create() == DebugData::create());
+	BOOST_CHECK(DebugData::create(location) != DebugData::create(location));
+}
+
+BOOST_AUTO_TEST_CASE(debug_data_table)
+{
+	SourceLocation const location{10, 20, make_shared<string const>("source0")};
+	SourceLocation const sameLocation{10, 20, location.sourceName};
+	SourceLocation const otherLocation{10, 21, location.sourceName};
+
+	DebugDataTable table;
+	shared_ptr<DebugData const> debugData = table.get(location, location, 7);
+	BOOST_CHECK(table.get(sameLocation, sameLocation, 7) == debugData);
+	BOOST_CHECK(table.get(location, location) != debugData);
+	BOOST_CHECK(table.get(location, otherLocation, 7) != debugData);
+	BOOST_CHECK(table.get(otherLocation, location, 7) != debugData);
+	BOOST_CHECK_EQUAL(table.size(), 4);
+	CHECK_LOCATION(debugData->nativeLocation, "source0", 10, 20);
+	CHECK_LOCATION(debugData->originLocation, "source0", 10, 20);
+	BOOST_CHECK(debugData->astID == 7);
+
+	BOOST_CHECK(table.get() == DebugData::create());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // end namespaces
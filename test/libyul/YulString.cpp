@@ -0,0 +1,104 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Unit tests for the YulString repository.
+ */
+
+#include <libyul/YulString.h>
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+
+using namespace std;
+
+namespace solidity::yul::test
+{
+
+BOOST_AUTO_TEST_SUITE(YulStringTest)
+
+BOOST_AUTO_TEST_CASE(empty_string)
+{
+	YulString empty;
+	BOOST_CHECK(empty.empty());
+	BOOST_CHECK(empty.str().empty());
+	BOOST_CHECK(YulString{""} == empty);
+	BOOST_CHECK(empty.hash() == YulStringRepository::emptyHash());
+	BOOST_CHECK(!"x"_yulstring.empty());
+}
+
+BOOST_AUTO_TEST_CASE(interning)
+{
+	YulString a{"abc"};
+	YulString b{string("ab") + "c"};
+	BOOST_CHECK(a == b);
+	BOOST_CHECK(&a.str() == &b.str());
+	BOOST_CHECK(a != "abd"_yulstring);
+	BOOST_CHECK(!(a < b) && !(b < a));
+	BOOST_CHECK_EQUAL(a.hash(), YulStringRepository::hash("abc"));
+}
+
+BOOST_AUTO_TEST_CASE(ordering_hash_is_fnv)
+{
+	// The optimiser output depends on this hash, so it must not change.
+	BOOST_CHECK_EQUAL(YulStringRepository::hash(""), 14695981039346656037u);
+	BOOST_CHECK_EQUAL(YulStringRepository::hash("a"), 0xaf63bd4c8601b7beu);
+	BOOST_CHECK_EQUAL("abc"_yulstring.hash(), YulStringRepository::hash("abc"));
+}
+
+BOOST_AUTO_TEST_CASE(lookup_hash)
+{
+	// Reference values of XXH64 with seed zero; they only hold on little-endian platforms.
+	uint16_t const one = 1;
+	if (*reinterpret_cast<unsigned char const*>(&one) != 1)
+		return;
+	BOOST_CHECK_EQUAL(YulStringRepository::lookupHash(""), 0xef46db3751d8e999u);
+	BOOST_CHECK_EQUAL(YulStringRepository::lookupHash("a"), 0xd24ec4f1a98c6e5bu);
+	BOOST_CHECK_EQUAL(YulStringRepository::lookupHash("abc"), 0x44bc2cf5ad770999u);
+	BOOST_CHECK_EQUAL(
+		YulStringRepository::lookupHash("abcdefghijklmnopqrstuvwxyz012345678901234567890123456789"),
+		0x75e6c25e2be8cf24u
+	);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_interning)
+{
+	size_t const threadCount = 4;
+	size_t const stringCount = 2000;
+	vector<vector<YulString>> results(threadCount);
+	vector<thread> threads;
+	for (size_t t = 0; t < threadCount; ++t)
+		threads.emplace_back([&, t]() {
+			for (size_t i = 0; i < stringCount; ++i)
+				results[t].emplace_back("str_" + to_string((i + t * 7) % stringCount));
+		});
+	for (auto& thread: threads)
+		thread.join();
+
+	for (size_t t = 0; t < threadCount; ++t)
+		for (size_t i = 0; i < stringCount; ++i)
+		{
+			YulString const& value = results[t][i];
+			BOOST_CHECK_EQUAL(value.str(), "str_" + to_string((i + t * 7) % stringCount));
+			BOOST_CHECK(value == YulString{value.str()});
+		}
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+}
@@ -1721,6 +1721,76 @@ class SolidityLSPTestSuite: # {{{
         self.expect_diagnostic(diagnostics[0], code=6321, marker=markers["@unusedReturnVariable"])
         self.expect_diagnostic(diagnostics[1], code=2072, marker=markers["@unusedContractVariable"])
 
+    def test_textDocument_didChange_without_changes_keeps_analysis(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        TEST_NAME = 'publish_diagnostics_1'
+        published_diagnostics = self.open_file_and_wait_for_diagnostics(solc, TEST_NAME, "goto")
+        self.expect_equal(len(published_diagnostics), 1, "One published_diagnostics message")
+        self.expect_equal(len(published_diagnostics[0]['diagnostics']), 3, "3 diagnostic messages")
+
+        def replace_content_and_wait_for_trace(content: str) -> dict:
+            solc.send_message(
+                'textDocument/didChange',
+                {
+                    'textDocument': {
+                        'uri': self.get_test_file_uri(TEST_NAME, "goto")
+                    },
+                    'contentChanges': [
+                        {
+                            'text': content
+                        }
+                    ]
+                }
+            )
+            trace = self.require_params_for_method('$/logTrace', solc.receive_message())
+            for _ in range(0, trace['openFileCount']):
+                report = self.require_params_for_method('textDocument/publishDiagnostics', solc.receive_message())
+                self.expect_equal(len(report['diagnostics']), 3, "3 diagnostic messages")
+            return trace
+
+        # Sending the content the server already has does not trigger a new analysis.
+        content = self.get_test_file_contents(TEST_NAME, "goto")
+        self.expect_equal(replace_content_and_wait_for_trace(content)['analyzed'], False, "previous analysis kept")
+
+        # Any change does.
+        self.expect_equal(replace_content_and_wait_for_trace(content + "\n")['analyzed'], True, "sources analyzed again")
+        self.expect_equal(replace_content_and_wait_for_trace(content + "\n")['analyzed'], False, "previous analysis kept")
+
+    def test_textDocument_didChange_does_not_read_unchanged_files_again(self, solc: JsonRpcProcess) -> None:
+        self.setup_lsp(solc)
+        TEST_NAME = 'didOpen_with_import'
+        published_diagnostics = self.open_file_and_wait_for_diagnostics(solc, TEST_NAME)
+        self.expect_equal(len(published_diagnostics), 2, "Diagnostic reports for 2 files")
+
+        def replace_content_and_wait_for_trace(content: str) -> dict:
+            solc.send_message(
+                'textDocument/didChange',
+                {
+                    'textDocument': {
+                        'uri': self.get_test_file_uri(TEST_NAME)
+                    },
+                    'contentChanges': [
+                        {
+                            'text': content
+                        }
+                    ]
+                }
+            )
+            trace = self.require_params_for_method('$/logTrace', solc.receive_message())
+            for _ in range(0, trace['openFileCount']):
+                self.require_params_for_method('textDocument/publishDiagnostics', solc.receive_message())
+            return trace
+
+        # The imported file (goto/lib.sol) did not change on disk, so it is taken from the cache,
+        # both when the analysis is kept and when it is not.
+        content = self.get_test_file_contents(TEST_NAME)
+        trace = replace_content_and_wait_for_trace(content)
+        self.expect_equal(trace['analyzed'], False, "previous analysis kept")
+        self.expect_equal(trace['filesReadFromDisk'], 0, "no files read from disk")
+        trace = replace_content_and_wait_for_trace(content + "\n")
+        self.expect_equal(trace['analyzed'], True, "sources analyzed again")
+        self.expect_equal(trace['filesReadFromDisk'], 0, "no files read from disk")
+
     def test_textDocument_didChange_delete_line_and_close(self, solc: JsonRpcProcess) -> None:
         # Reuse this test to prepare and ensure it is as expected
         self.test_textDocument_didOpen_with_relative_import(solc)
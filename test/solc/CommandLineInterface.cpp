@@ -398,6 +398,74 @@ BOOST_AUTO_TEST_CASE(standard_json_remapping)
 	);
 }
 
+BOOST_AUTO_TEST_CASE(server_input_lines)
+{
+	string const validInput = R"({"language": "Solidity", "sources": {"A.sol": {"content": "contract A {}"}}})";
+	string const invalidInput = R"({"language": "Solidity", "sources": )";
+
+	OptionsReaderAndMessages result = runCLI(
+		{"solc", "--server"},
+		validInput + "\n\n" + invalidInput + "\n" + validInput + "\n"
+	);
+	BOOST_REQUIRE(result.success);
+	BOOST_TEST(result.options.input.mode == InputMode::Server);
+
+	vector<string> outputs;
+	boost::split(outputs, result.stdoutContent, boost::is_any_of("\n"));
+	BOOST_REQUIRE(outputs.size() == 4);
+	BOOST_TEST(outputs[3].empty());
+
+	Json::Value validOutput;
+	BOOST_REQUIRE(util::jsonParseStrict(outputs[0], validOutput));
+	BOOST_TEST(validOutput["sources"].isMember("A.sol"));
+	Json::Value invalidOutput;
+	BOOST_REQUIRE(util::jsonParseStrict(outputs[1], invalidOutput));
+	BOOST_TEST(invalidOutput["errors"][0]["type"] == "JSONError");
+	BOOST_TEST(outputs[2] == outputs[0]);
+}
+
+BOOST_AUTO_TEST_CASE(server_input_lines_importing_files)
+{
+	TemporaryDirectory tempDir(TEST_CASE_NAME);
+	TemporaryWorkingDirectory tempWorkDir(tempDir);
+	createFilesWithParentDirs({tempDir.path() / "imported.sol"}, "contract I {}");
+
+	string const inputA = R"({"language": "Solidity", "sources": {"A.sol": {"content": "import \"imported.sol\"; contract A is I {}"}}})";
+	string const inputB = R"({"language": "Solidity", "sources": {"B.sol": {"content": "import \"imported.sol\"; contract B is I {}"}}})";
+
+	OptionsReaderAndMessages result = runCLI(
+		{"solc", "--server"},
+		inputA + "\n" + inputB + "\n" + inputA + "\n"
+	);
+	BOOST_REQUIRE(result.success);
+
+	vector<string> outputs;
+	boost::split(outputs, result.stdoutContent, boost::is_any_of("\n"));
+	BOOST_REQUIRE(outputs.size() == 4);
+	for (size_t i = 0; i < 3; ++i)
+	{
+		Json::Value output;
+		BOOST_REQUIRE(util::jsonParseStrict(outputs[i], output));
+		for (Json::Value const& error: output["errors"])
+			BOOST_TEST(error["severity"] != "error");
+		BOOST_TEST(output["sources"].isMember("imported.sol"));
+	}
+	BOOST_TEST(outputs[2] == outputs[0]);
+}
+
+BOOST_AUTO_TEST_CASE(server_input_file)
+{
+	string expectedMessage =
+		"Input files are not accepted by --server.\n"
+		"Please send the standard JSON inputs on standard input, one per line.";
+
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLineAndReadInputFiles({"solc", "--server", "input.json"}),
+		CommandLineValidationError,
+		[&](auto const& _exception) { BOOST_TEST(_exception.what() == expectedMessage); return true; }
+	);
+}
+
 BOOST_AUTO_TEST_CASE(cli_paths_to_source_unit_names_no_base_path)
 {
 	TemporaryDirectory tempDirCurrent(TEST_CASE_NAME);
@@ -31,6 +31,7 @@
 #include <libsmtutil/SolverInterface.h>
 #include <libsolidity/interface/Version.h>
 
+#include <limits>
 #include <map>
 #include <optional>
 #include <ostream>
@@ -124,6 +125,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			"--experimental-via-ir",
 			"--revert-strings=strip",
 			"--debug-info=location",
+			"--jobs=4",
 			"--pretty-json",
 			"--json-indent=7",
 			"--no-color",
@@ -132,7 +134,8 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 				"dir1/file1.sol:L=0x1234567890123456789012345678901234567890,"
 				"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
 			"--ast-compact-json", "--asm", "--asm-json", "--opcodes", "--bin", "--bin-runtime", "--abi",
-			"--ir", "--ir-ast-json", "--ir-optimized", "--ir-optimized-ast-json", "--hashes", "--userdoc", "--devdoc", "--metadata", "--storage-layout",
+			"--ir", "--ir-ast-json", "--ir-optimized", "--ir-optimized-ast-json", "--optimizer-profile",
+			"--hashes", "--userdoc", "--devdoc", "--metadata", "--storage-layout",
 			"--gas",
 			"--combined-json="
 				"abi,metadata,bin,bin-runtime,opcodes,asm,storage-layout,generated-sources,generated-sources-runtime,"
@@ -184,6 +187,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 		expectedOptions.output.viaIR = true;
 		expectedOptions.output.revertStrings = RevertStrings::Strip;
 		expectedOptions.output.debugInfoSelection = DebugInfoSelection::fromString("location");
+		expectedOptions.output.parallelJobs = 4;
 		expectedOptions.formatting.json = JsonFormat{JsonFormat::Pretty, 7};
 		expectedOptions.linker.libraries = {
 			{"dir1/file1.sol:L", h160("1234567890123456789012345678901234567890")},
@@ -195,7 +199,7 @@ BOOST_AUTO_TEST_CASE(cli_mode_options)
 			true, true, true, true, true,
 			true, true, true, true, true,
 			true, true, true, true, true,
-			true,
+			true, true,
 		};
 		expectedOptions.compiler.estimateGas = true;
 		expectedOptions.compiler.combinedJsonRequests = {
@@ -250,6 +254,16 @@ BOOST_AUTO_TEST_CASE(via_ir_options)
 		BOOST_TEST(parseCommandLine({"solc", viaIrOption, "contract.sol"}).output.viaIR);
 }
 
+BOOST_AUTO_TEST_CASE(jobs_option)
+{
+	BOOST_TEST(parseCommandLine({"solc", "contract.sol"}).output.parallelJobs == 1);
+	BOOST_TEST(parseCommandLine({"solc", "--jobs=8", "contract.sol"}).output.parallelJobs == 8);
+
+	string expectedMessage = "--jobs must be at least 1.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(parseCommandLine({"solc", "--jobs=0", "contract.sol"}), CommandLineValidationError, hasCorrectMessage);
+}
+
 BOOST_AUTO_TEST_CASE(assembly_mode_options)
 {
 	static vector<tuple<vector<string>, YulStack::Machine, YulStack::Language>> const allowedCombinations = {
@@ -375,6 +389,8 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 			"dir2/file2.sol:L=0x1111122222333334444455555666667777788888",
 		"--gas",                           // Accepted but has no effect in Standard JSON mode
 		"--combined-json=abi,bin",         // Accepted but has no effect in Standard JSON mode
+		"--cache-dir=/tmp/cache",
+		"--cache-size=64",
 	};
 
 	CommandLineOptions expectedOptions;
@@ -395,12 +411,40 @@ BOOST_AUTO_TEST_CASE(standard_json_mode_options)
 	expectedOptions.compiler.combinedJsonRequests = CombinedJsonRequests{};
 	expectedOptions.compiler.combinedJsonRequests->abi = true;
 	expectedOptions.compiler.combinedJsonRequests->binary = true;
+	expectedOptions.cache.directory = "/tmp/cache";
+	expectedOptions.cache.maxSize = 64 * 1024 * 1024;
 
 	CommandLineOptions parsedOptions = parseCommandLine(commandLine);
 
 	BOOST_TEST(parsedOptions == expectedOptions);
 }
 
+BOOST_AUTO_TEST_CASE(cache_size_requires_cache_dir)
+{
+	string expectedMessage = "--cache-size requires --cache-dir.";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLine({"solc", "--standard-json", "--cache-size=64", "input.json"}),
+		CommandLineValidationError,
+		hasCorrectMessage
+	);
+}
+
+BOOST_AUTO_TEST_CASE(cache_size_overflow)
+{
+	uint64_t const maxSizeInMiB = numeric_limits<uint64_t>::max() / (1024 * 1024);
+	string expectedMessage = "--cache-size must be at most " + to_string(maxSizeInMiB) + ".";
+	auto hasCorrectMessage = [&](CommandLineValidationError const& _exception) { return _exception.what() == expectedMessage; };
+	BOOST_CHECK_EXCEPTION(
+		parseCommandLine({"solc", "--standard-json", "--cache-dir=/tmp/cache", "--cache-size=" + to_string(maxSizeInMiB + 1), "input.json"}),
+		CommandLineValidationError,
+		hasCorrectMessage
+	);
+
+	CommandLineOptions parsedOptions = parseCommandLine({"solc", "--standard-json", "--cache-dir=/tmp/cache", "--cache-size=" + to_string(maxSizeInMiB), "input.json"});
+	BOOST_TEST(parsedOptions.cache.maxSize == maxSizeInMiB * 1024 * 1024);
+}
+
 BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 {
 	map<string, vector<string>> invalidOptionInputModeCombinations = {
@@ -408,6 +452,8 @@ BOOST_AUTO_TEST_CASE(invalid_options_input_modes_combinations)
 		{"--error-recovery", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--experimental-via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--via-ir", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--jobs=4", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
+		{"--cache-dir=/tmp/cache", {"--assemble", "--yul", "--strict-assembly", "--link"}},
 		{"--metadata-literal", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--metadata-hash=swarm", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
 		{"--model-checker-show-proved-safe", {"--assemble", "--yul", "--strict-assembly", "--standard-json", "--link"}},
@@ -0,0 +1,216 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Benchmark for the legacy assembly optimiser.
+ * Generates the unoptimised assembly of all contracts in the given Solidity files
+ * and measures the wall time and the number of heap allocations of Assembly::optimise,
+ * optionally restricted to the common subexpression eliminator.
+ */
+
+#include <libsolidity/ast/AST.h>
+#include <libsolidity/codegen/Compiler.h>
+#include <libsolidity/interface/CompilerStack.h>
+#include <libsolidity/interface/DebugSettings.h>
+#include <libsolidity/interface/OptimiserSettings.h>
+
+#include <libevmasm/Assembly.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/program_options.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::frontend;
+using namespace solidity::langutil;
+using namespace solidity::util;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+atomic<size_t> allocationCount{0};
+
+using Compilers = map<ContractDefinition const*, shared_ptr<Compiler const>>;
+
+/// Generates the unoptimised assembly of @a _contract and its dependencies, in the same order
+/// as CompilerStack does. @a _order receives the compilers in the order they are created.
+void compile(
+	ContractDefinition const& _contract,
+	EVMVersion _evmVersion,
+	Compilers& _compilers,
+	vector<shared_ptr<Compiler>>& _order
+)
+{
+	if (_compilers.count(&_contract))
+		return;
+	for (auto const& [dependency, referencee]: _contract.annotation().contractDependencies)
+		compile(*dependency, _evmVersion, _compilers, _order);
+	if (!_contract.canBeDeployed())
+		return;
+
+	auto compiler = make_shared<Compiler>(_evmVersion, RevertStrings::Default, OptimiserSettings::none());
+	compiler->compileContract(_contract, _compilers, bytes{});
+	_compilers[&_contract] = compiler;
+	_order.push_back(compiler);
+}
+
+}
+
+void* operator new(size_t _size)
+{
+	++allocationCount;
+	if (void* pointer = malloc(_size))
+		return pointer;
+	throw bad_alloc();
+}
+
+void operator delete(void* _pointer) noexcept
+{
+	free(_pointer);
+}
+
+void operator delete(void* _pointer, size_t) noexcept
+{
+	free(_pointer);
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		size_t rounds = 5;
+		bool cseOnly = false;
+		po::options_description options(
+			R"(evmasmbench, benchmark for the legacy assembly optimiser.
+	Usage: evmasmbench [Options] <file>...
+	Generates the unoptimised assembly of all contracts in the given Solidity files
+	and measures how long optimising it with the standard settings takes
+	and how many heap allocations that needs.
+	With --cse-only, only the common subexpression eliminator is run.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"input-file",
+				po::value<vector<string>>(),
+				"input files"
+			)
+			(
+				"rounds",
+				po::value<size_t>(&rounds)->default_value(rounds),
+				"number of times the assembly is generated and optimised"
+			)
+			(
+				"cse-only",
+				po::bool_switch(&cseOnly),
+				"only run the common subexpression eliminator"
+			)
+			("help,h", "Show this help screen.");
+
+		po::positional_options_description filesPositions;
+		filesPositions.add("input-file", -1);
+
+		po::variables_map arguments;
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help") || !arguments.count("input-file") || rounds == 0)
+		{
+			cout << options;
+			return arguments.count("help") ? 0 : 1;
+		}
+
+		map<string, string> sources;
+		for (string const& file: arguments["input-file"].as<vector<string>>())
+			sources[file] = readFileAsString(file);
+
+		EVMVersion const evmVersion;
+		CompilerStack stack;
+		stack.setSources(sources);
+		stack.setEVMVersion(evmVersion);
+		if (!stack.parseAndAnalyze())
+		{
+			cerr << "The input files contain errors." << endl;
+			return 1;
+		}
+		auto settings = evmasm::Assembly::OptimiserSettings::translateSettings(
+			cseOnly ? OptimiserSettings::none() : OptimiserSettings::standard(),
+			evmVersion
+		);
+		if (cseOnly)
+			settings.runCSE = true;
+
+		double fastest = 0.0;
+		size_t allocations = 0;
+		size_t items = 0;
+		for (size_t round = 0; round < rounds; ++round)
+		{
+			Compilers compilers;
+			vector<shared_ptr<Compiler>> order;
+			for (string const& contractName: stack.contractNames())
+				compile(stack.contractDefinition(contractName), evmVersion, compilers, order);
+			if (round == 0)
+				for (auto const& compiler: order)
+					items += compiler->assembly().items().size() + compiler->runtimeAssembly().items().size();
+
+			size_t allocationsBefore = allocationCount;
+			auto start = chrono::steady_clock::now();
+			for (auto const& compiler: order)
+				compiler->assemblyPtr()->optimise(settings);
+			double duration = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+			allocations = allocationCount - allocationsBefore;
+			fastest = (round == 0) ? duration : min(fastest, duration);
+		}
+
+		cout <<
+			sources.size() << " files, " << items << " unoptimised items, " << rounds << " rounds" << endl <<
+			(cseOnly ? "CSE: " : "Assembly::optimise: ") << fixed << setprecision(1) << fastest << " ms, " <<
+			allocations << " allocations" << endl;
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	catch (FileNotFound const& _exception)
+	{
+		cerr << "File not found: " << _exception.comment() << endl;
+		return 1;
+	}
+
+	return 0;
+}
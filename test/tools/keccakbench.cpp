@@ -0,0 +1,242 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Microbenchmark for Keccak-256.
+ * Measures hashing function signatures (as done for every selector and event topic)
+ * and large inputs (as done for source files and bytecode), one by one and through the
+ * batch interface, compared to the libkeccak-tiny permutation that was used before.
+ */
+
+#include <libsolutil/Keccak256.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// The Keccak-f[1600] permutation of libkeccak-tiny (CC0), as used before.
+uint8_t const rho[24] = {
+	1, 3, 6, 10, 15, 21, 28, 36, 45, 55, 2, 14, 27, 41, 56, 8, 25, 43, 62, 18, 39, 61, 20, 44
+};
+uint8_t const pi[24] = {
+	10, 7, 11, 17, 18, 3, 5, 16, 8, 21, 24, 4, 15, 23, 19, 13, 12, 2, 20, 14, 22, 9, 6, 1
+};
+uint64_t const RC[24] = {
+	1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+	0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+	0x8aULL, 0x88ULL, 0x80008009ULL, 0x8000000aULL,
+	0x8000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+	0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL, 0x800000008000000aULL,
+	0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL
+};
+
+#define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
+#define REPEAT6(e) e e e e e e
+#define REPEAT24(e) REPEAT6(e e e e)
+#define REPEAT5(e) e e e e e
+#define FOR5(type, v, s, e) \
+	v = 0; \
+	REPEAT5(e; v = static_cast<type>(v + s);)
+
+void referenceKeccakf(uint64_t* a)
+{
+	uint64_t b[5] = {0};
+	for (int i = 0; i < 24; i++)
+	{
+		uint8_t x, y;
+		// Theta
+		FOR5(uint8_t, x, 1,
+			b[x] = 0;
+			FOR5(uint8_t, y, 5,
+				b[x] ^= a[x + y]; ))
+		FOR5(uint8_t, x, 1,
+			FOR5(uint8_t, y, 5,
+				a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1); ))
+		// Rho and pi
+		uint64_t t = a[1];
+		x = 0;
+		REPEAT24(b[0] = a[pi[x]];
+				a[pi[x]] = rol(t, rho[x]);
+				t = b[0];
+				x++; )
+		// Chi
+		FOR5(uint8_t, y, 5,
+			FOR5(uint8_t, x, 1,
+				b[x] = a[y + x];)
+			FOR5(uint8_t, x, 1,
+				a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]); ))
+		// Iota
+		a[0] ^= RC[i];
+	}
+}
+
+#undef FOR5
+#undef REPEAT5
+#undef REPEAT24
+#undef REPEAT6
+#undef rol
+
+h256 referenceKeccak256(bytesConstRef _input)
+{
+	size_t constexpr rate = 136;
+	uint64_t state[25] = {};
+	auto* bytes = reinterpret_cast<uint8_t*>(state);
+	uint8_t const* data = _input.data();
+	size_t size = _input.size();
+	for (; size >= rate; data += rate, size -= rate)
+	{
+		for (size_t i = 0; i < rate; ++i)
+			bytes[i] ^= data[i];
+		referenceKeccakf(state);
+	}
+	for (size_t i = 0; i < size; ++i)
+		bytes[i] ^= data[i];
+	bytes[size] ^= 0x01;
+	bytes[rate - 1] ^= 0x80;
+	referenceKeccakf(state);
+	h256 output;
+	memcpy(output.data(), bytes, output.size);
+	return output;
+}
+
+template <typename Function>
+void measure(string const& _name, size_t _rounds, vector<bytesConstRef> const& _inputs, Function _function)
+{
+	size_t totalSize = 0;
+	for (bytesConstRef input: _inputs)
+		totalSize += input.size();
+	uint8_t checksum = 0;
+	auto start = chrono::steady_clock::now();
+	for (size_t round = 0; round < _rounds; ++round)
+		checksum = static_cast<uint8_t>(checksum + _function(_inputs));
+	auto duration = chrono::duration<double, nano>(chrono::steady_clock::now() - start);
+	double perInput = duration.count() / static_cast<double>(_rounds * _inputs.size());
+	double megabytesPerSecond = static_cast<double>(_rounds * totalSize) / (duration.count() / 1000.0);
+	cout <<
+		left << setw(24) << _name <<
+		right << setw(12) << fixed << setprecision(1) << perInput << " ns/input" <<
+		setw(10) << setprecision(1) << megabytesPerSecond << " MB/s" <<
+		"  (checksum " << hex << static_cast<unsigned>(checksum) << dec << ")" << endl;
+}
+
+void measureAll(string const& _title, size_t _rounds, vector<bytesConstRef> const& _inputs)
+{
+	cout << _title << ", " << _rounds << " rounds" << endl;
+	measure("libkeccak-tiny", _rounds, _inputs, [](vector<bytesConstRef> const& _data) {
+		uint8_t checksum = 0;
+		for (bytesConstRef input: _data)
+			checksum ^= referenceKeccak256(input)[0];
+		return checksum;
+	});
+	measure("keccak256", _rounds, _inputs, [](vector<bytesConstRef> const& _data) {
+		uint8_t checksum = 0;
+		for (bytesConstRef input: _data)
+			checksum ^= keccak256(input)[0];
+		return checksum;
+	});
+	measure("keccak256 (batch)", _rounds, _inputs, [](vector<bytesConstRef> const& _data) {
+		uint8_t checksum = 0;
+		for (h256 const& hash: keccak256(_data))
+			checksum ^= hash[0];
+		return checksum;
+	});
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		size_t rounds = 20;
+		size_t signatures = 10000;
+		size_t largeInputs = 4;
+		po::options_description options(
+			R"(keccakbench, benchmark for Keccak-256.
+	Usage: keccakbench [Options]
+	Measures hashing function signatures and inputs of 1 MB, both one by one
+	and four at a time, against the previous implementation.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"rounds",
+				po::value<size_t>(&rounds)->default_value(rounds),
+				"number of passes over the inputs"
+			)
+			(
+				"signatures",
+				po::value<size_t>(&signatures)->default_value(signatures),
+				"number of function signatures"
+			)
+			(
+				"large-inputs",
+				po::value<size_t>(&largeInputs)->default_value(largeInputs),
+				"number of inputs of 1 MB"
+			)
+			("help,h", "Show this help screen.");
+
+		po::variables_map arguments;
+		po::store(po::parse_command_line(argc, argv, options), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help") || rounds == 0)
+		{
+			cout << options;
+			return arguments.count("help") ? 0 : 1;
+		}
+
+		vector<string> signatureData;
+		for (size_t i = 0; i < signatures; ++i)
+			signatureData.emplace_back("transfer" + to_string(i) + "(address,uint256,bytes)");
+		vector<bytesConstRef> signatureInputs;
+		for (string const& signature: signatureData)
+			signatureInputs.emplace_back(signature);
+		measureAll(to_string(signatures) + " function signatures", rounds * 10, signatureInputs);
+
+		vector<bytes> largeData;
+		for (size_t i = 0; i < largeInputs; ++i)
+			largeData.emplace_back(1024 * 1024, static_cast<uint8_t>(i));
+		vector<bytesConstRef> largeDataInputs;
+		for (bytes const& input: largeData)
+			largeDataInputs.emplace_back(&input);
+		measureAll(to_string(largeInputs) + " inputs of 1 MB", rounds, largeDataInputs);
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,219 @@
+/*
+	This file is part of solidity.
+
+	solidity is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	solidity is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with solidity.  If not, see <http://www.gnu.org/licenses/>.
+*/
+// SPDX-License-Identifier: GPL-3.0
+/**
+ * Microbenchmark for interning Yul identifiers.
+ * Extracts all identifiers from the given Yul files (e.g. the output of solc --ir)
+ * and measures the hash functions and the interning throughput of the YulString repository,
+ * compared to a single-mutex repository that hashes every lookup with FNV.
+ */
+
+#include <libyul/YulString.h>
+
+#include <libsolutil/CommonIO.h>
+#include <libsolutil/Exceptions.h>
+
+#include <boost/program_options.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+using namespace solidity;
+using namespace solidity::util;
+using namespace solidity::yul;
+
+namespace po = boost::program_options;
+
+namespace
+{
+
+/// Repository as it was before lookups used a separate hash.
+class FNVRepository
+{
+public:
+	pair<string const*, uint64_t> intern(string const& _string)
+	{
+		uint64_t h = YulStringRepository::hash(_string);
+		lock_guard<mutex> lock(m_mutex);
+		auto range = m_hashToString.equal_range(h);
+		for (auto it = range.first; it != range.second; ++it)
+			if (*it->second == _string)
+				return {it->second, h};
+		m_strings.emplace_back(make_shared<string>(_string));
+		m_hashToString.emplace_hint(range.second, h, m_strings.back().get());
+		return {m_strings.back().get(), h};
+	}
+
+private:
+	mutex m_mutex;
+	vector<shared_ptr<string>> m_strings;
+	unordered_multimap<uint64_t, string const*> m_hashToString;
+};
+
+bool isIdentifierStart(char _c)
+{
+	return (_c >= 'a' && _c <= 'z') || (_c >= 'A' && _c <= 'Z') || _c == '_' || _c == '$';
+}
+
+bool isIdentifierPart(char _c)
+{
+	return isIdentifierStart(_c) || (_c >= '0' && _c <= '9') || _c == '.';
+}
+
+/// Extracts all identifiers, skipping comments, string literals and numbers.
+vector<string> identifiers(string const& _source)
+{
+	vector<string> result;
+	size_t i = 0;
+	while (i < _source.size())
+	{
+		char c = _source[i];
+		if (_source.compare(i, 2, "//") == 0)
+			i = min(_source.find('\n', i), _source.size());
+		else if (_source.compare(i, 2, "/*") == 0)
+			i = min(_source.find("*/", i + 2), _source.size() - 2) + 2;
+		else if (c == '"')
+		{
+			for (++i; i < _source.size() && _source[i] != '"'; ++i)
+				if (_source[i] == '\\')
+					++i;
+			++i;
+		}
+		else if (isIdentifierStart(c))
+		{
+			size_t start = i;
+			while (i < _source.size() && isIdentifierPart(_source[i]))
+				++i;
+			result.emplace_back(_source.substr(start, i - start));
+		}
+		else if (c >= '0' && c <= '9')
+			while (i < _source.size() && isIdentifierPart(_source[i]))
+				++i;
+		else
+			++i;
+	}
+	return result;
+}
+
+template <typename Function>
+void measure(string const& _name, size_t _rounds, vector<string> const& _corpus, Function _function)
+{
+	uint64_t checksum = 0;
+	auto start = chrono::steady_clock::now();
+	for (size_t round = 0; round < _rounds; ++round)
+		for (string const& identifier: _corpus)
+			checksum += _function(identifier);
+	auto duration = chrono::duration<double, nano>(chrono::steady_clock::now() - start);
+	double perIdentifier = duration.count() / static_cast<double>(_rounds * _corpus.size());
+	cout <<
+		left << setw(28) << _name <<
+		right << setw(10) << fixed << setprecision(2) << perIdentifier << " ns/identifier" <<
+		setw(10) << setprecision(1) << 1000.0 / perIdentifier << " M/s" <<
+		"  (checksum " << hex << (checksum & 0xffff) << dec << ")" << endl;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+	try
+	{
+		size_t rounds = 20;
+		po::options_description options(
+			R"(yulstringbench, benchmark for interning Yul identifiers.
+	Usage: yulstringbench [Options] <file>...
+	Reads the given Yul files (e.g. produced by solc --ir) and measures
+	the throughput of hashing and interning all identifiers in them.
+
+	Allowed options)",
+			po::options_description::m_default_line_length,
+			po::options_description::m_default_line_length - 23);
+		options.add_options()
+			(
+				"input-file",
+				po::value<vector<string>>(),
+				"input files"
+			)
+			(
+				"rounds",
+				po::value<size_t>(&rounds)->default_value(rounds),
+				"number of passes over the identifiers"
+			)
+			("help,h", "Show this help screen.");
+
+		po::positional_options_description filesPositions;
+		filesPositions.add("input-file", -1);
+
+		po::variables_map arguments;
+		po::command_line_parser cmdLineParser(argc, argv);
+		cmdLineParser.options(options).positional(filesPositions);
+		po::store(cmdLineParser.run(), arguments);
+		po::notify(arguments);
+
+		if (arguments.count("help") || !arguments.count("input-file") || rounds == 0)
+		{
+			cout << options;
+			return arguments.count("help") ? 0 : 1;
+		}
+
+		vector<string> corpus;
+		for (string const& file: arguments["input-file"].as<vector<string>>())
+		{
+			vector<string> fileIdentifiers = identifiers(readFileAsString(file));
+			corpus.insert(corpus.end(), fileIdentifiers.begin(), fileIdentifiers.end());
+		}
+		if (corpus.empty())
+		{
+			cerr << "No identifiers found." << endl;
+			return 1;
+		}
+		size_t totalLength = 0;
+		for (string const& identifier: corpus)
+			totalLength += identifier.size();
+		cout <<
+			corpus.size() << " identifiers, average length " <<
+			fixed << setprecision(1) << static_cast<double>(totalLength) / static_cast<double>(corpus.size()) <<
+			", " << rounds << " rounds" << endl;
+
+		measure("FNV hash", rounds, corpus, [](string const& _s) { return YulStringRepository::hash(_s); });
+		measure("lookup hash", rounds, corpus, [](string const& _s) { return YulStringRepository::lookupHash(_s); });
+
+		FNVRepository fnvRepository;
+		measure("intern (FNV, single mutex)", rounds, corpus, [&](string const& _s) {
+			return fnvRepository.intern(_s).second;
+		});
+		measure("intern (YulString)", rounds, corpus, [](string const& _s) { return YulString(_s).hash(); });
+	}
+	catch (po::error const& _exception)
+	{
+		cerr << _exception.what() << endl;
+		return 1;
+	}
+	catch (FileNotFound const& _exception)
+	{
+		cerr << "File not found: " << _exception.comment() << endl;
+		return 1;
+	}
+
+	return 0;
+}